@@ -0,0 +1,3287 @@
+// Graph library shared by the labs: edges files (text and binary), the
+// Graph class template and the helpers its queries use. Every lab includes
+// this header and keeps only its main.
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <type_traits>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+// Number of a vertex in the edges files, any 64-bit integer. Inside a
+// Graph vertices are renumbered to dense indices 0 .. N() - 1.
+typedef int64_t VertexId;
+
+// whether id is one of first .. first + count - 1, without overflow
+inline bool in_range(VertexId id, VertexId first, long long count) {
+	return id >= first && uint64_t(id) - uint64_t(first) < uint64_t(count);
+}
+
+// Weight type of graphs without weights, nothing is stored for it.
+struct Unweighted {};
+
+// Weight w as a T. Integers that do not fit in T throw out_of_range
+// instead of being truncated; other weights are converted as they are.
+template <class T, class W>
+typename enable_if<is_integral<T>::value && is_integral<W>::value, T>::type weight_cast(W w) {
+	T x = T(w);
+	if (W(x) != w || (x < T(0)) != (w < W(0)))
+		throw out_of_range("weight_cast: weight out of range");
+	return x;
+}
+
+template <class T, class W>
+typename enable_if<!(is_integral<T>::value && is_integral<W>::value), T>::type weight_cast(W w) {
+	return T(w);
+}
+
+// Edge a - b of weight w. Vertex is a VertexId in the files and the index
+// of the vertex inside a Graph.
+template <class Vertex, class Weight = Unweighted>
+struct BasicEdge {
+	Vertex a, b;
+	Weight w;
+
+	// throws out_of_range if w does not fit in Weight, see weight_cast
+	template <class W>
+	static BasicEdge make(Vertex a, Vertex b, W w) {
+		return { a, b, weight_cast<Weight>(w) };
+	}
+
+	bool operator< (const BasicEdge & e) const {
+		return w > e.w;
+	}
+	friend ostream & operator<< (ostream & s, const BasicEdge & e) {
+		return s << e.a << " " << e.b << " " << e.w;
+	}
+};
+
+template <class Vertex>
+struct BasicEdge<Vertex, Unweighted> {
+	Vertex a, b;
+
+	// the weight is dropped
+	template <class W>
+	static BasicEdge make(Vertex a, Vertex b, W) {
+		return { a, b };
+	}
+
+	friend ostream & operator<< (ostream & s, const BasicEdge & e) {
+		return s << e.a << " " << e.b << " ";
+	}
+};
+
+// weight of e as stored in the files, 1 for an unweighted edge
+template <class Vertex, class Weight>
+inline Weight edge_weight(const BasicEdge<Vertex, Weight> & e) {
+	return e.w;
+}
+
+template <class Vertex>
+inline int edge_weight(const BasicEdge<Vertex, Unweighted> &) {
+	return 1;
+}
+
+// Next integer of the text at p, anything else in between is skipped.
+// p is moved past the number; false if the text has no more numbers.
+// Throws out_of_range if the number does not fit in T.
+template <class T>
+bool parse_int(const char *& p, const char * end, T & x) {
+	typedef typename make_unsigned<T>::type U;
+	while (p != end && (*p < '0' || *p > '9') && *p != '-')
+		++p;
+	if (p == end)
+		return false;
+	bool negative = *p == '-';
+	if (negative)
+		++p;
+	// the magnitude is accumulated unsigned, so the check itself cannot overflow
+	U limit = U(numeric_limits<T>::max()) + (negative ? 1 : 0);
+	U res = 0;
+	while (p != end && *p >= '0' && *p <= '9') {
+		U d = *p++ - '0';
+		if (res > (limit - d) / 10)
+			throw out_of_range("parse_int: number out of range");
+		res = res * 10 + d;
+	}
+	x = negative && res ? -T(res - 1) - 1 : T(res);
+	return true;
+}
+
+// Next edge of the text at p, "a b" or "a b w" for a weighted one.
+inline bool parse_edge(const char *& p, const char * end, BasicEdge<VertexId> & e) {
+	return parse_int(p, end, e.a) && parse_int(p, end, e.b);
+}
+
+template <class Weight>
+inline bool parse_edge(const char *& p, const char * end, BasicEdge<VertexId, Weight> & e) {
+	return parse_int(p, end, e.a) && parse_int(p, end, e.b) && parse_int(p, end, e.w);
+}
+
+// Edges file: the number of vertices N, then the edges "a b", or "a b w"
+// with an integer weight if Weight is not Unweighted, separated by any
+// whitespace. The file is read with a single call and cut at whitespace
+// into chunks of at least a megabyte, whose numbers are parsed on separate
+// threads; they are paired into edges by their position in the whole file,
+// so an edge may span two chunks and the edges keep their order in the
+// file. An incomplete last edge is dropped. Throws if a number does not fit
+// in its type.
+template <class Weight>
+vector<BasicEdge<VertexId, Weight>> read_edges_file(const string & filename, int & N) {
+	typedef BasicEdge<VertexId, Weight> Edge;
+	const size_t ARITY = is_same<Weight, Unweighted>::value ? 2 : 3;
+	vector<char> text;
+	ifstream f(filename, ios::binary);
+	if (f) {
+		f.seekg(0, ios::end);
+		text.resize(size_t(f.tellg()));
+		f.seekg(0, ios::beg);
+		f.read(text.data(), text.size());
+	}
+	const char * p = text.data();
+	const char * end = p + text.size();
+	N = 0;
+	try {
+		parse_int(p, end, N);
+	}
+	catch (const out_of_range &) {
+		throw runtime_error(filename + ": number of vertices out of range");
+	}
+
+	auto space = [](char c) { return c == ' ' || (c >= '\t' && c <= '\r'); };
+	size_t T = min<size_t>(thread::hardware_concurrency(), size_t(end - p) >> 20);
+	T = max<size_t>(T, 1);
+	vector<const char *> cut(T + 1, end);
+	cut[0] = p;
+	for (size_t t = 1; t < T; ++t) {
+		const char * c = max(cut[t - 1], p + size_t(end - p) / T * t);
+		while (c != end && !space(*c))
+			++c;
+		cut[t] = c;
+	}
+
+	// numbers of every chunk, then the edges starting in it
+	vector<vector<int64_t>> number(T);
+	vector<size_t> first(T + 1, 0);
+	vector<Edge> edges;
+	vector<char> overflow(T, 0);
+	auto run = [&](function<void(size_t)> f) {
+		vector<thread> workers;
+		for (size_t t = 1; t < T; ++t)
+			workers.emplace_back(f, t);
+		f(0);
+		for (auto & w : workers)
+			w.join();
+		if (count(overflow.begin(), overflow.end(), 1))
+			throw runtime_error(filename + ": number out of range");
+	};
+	run([&](size_t t) {
+		const char * q = cut[t];
+		int64_t x;
+		try {
+			while (parse_int(q, cut[t + 1], x))
+				number[t].push_back(x);
+		}
+		catch (const out_of_range &) {
+			overflow[t] = 1;
+		}
+	});
+	for (size_t t = 0; t < T; ++t)
+		first[t + 1] = first[t] + number[t].size();
+
+	edges.resize(first[T] / ARITY);
+	run([&](size_t t) {
+		// k-th number of the file, looked up in the chunks for edges
+		// that span them
+		auto at = [&](size_t k) {
+			size_t c = t;
+			while (k >= first[c + 1])
+				++c;
+			return number[c][k - first[c]];
+		};
+		size_t from = (first[t] + ARITY - 1) / ARITY;
+		size_t to = min(edges.size(), (first[t + 1] + ARITY - 1) / ARITY);
+		try {
+			for (size_t i = from; i < to; ++i) {
+				size_t k = i * ARITY;
+				if (k + ARITY <= first[t + 1]) {
+					auto x = &number[t][k - first[t]];
+					edges[i] = Edge::make(x[0], x[1], ARITY == 3 ? x[ARITY - 1] : 1);
+				}
+				else {
+					edges[i] = Edge::make(at(k), at(k + 1), ARITY == 3 ? at(k + ARITY - 1) : 1);
+				}
+			}
+		}
+		catch (const out_of_range &) {
+			overflow[t] = 1;
+		}
+	});
+	return edges;
+}
+
+// Index of a vertex by its number in the input files, -1 for numbers that
+// are not vertices. Consecutive numbers, such as 1 .. N of a whole input
+// file, map by a shift and take no memory; any other set of numbers goes
+// through an open addressing hash table with at least twice as many slots.
+template <class Index = int>
+class VertexIndex {
+	VertexId first = 0;
+	Index count = 0;
+	vector<VertexId> key;
+	vector<Index> value;
+	int shift = 64;
+
+	size_t slot(VertexId id) const {
+		return size_t((unsigned long long)id * 0x9E3779B97F4A7C15ull >> shift);
+	}
+
+public:
+	// numbers first .. first + count - 1
+	void assign_dense(VertexId first, Index count) {
+		this->first = first;
+		this->count = count;
+		key.clear();
+		value.clear();
+	}
+
+	// ids[i] is the number of vertex i
+	void assign(const vector<VertexId> & ids) {
+		bool dense = true;
+		for (size_t i = 1; i < ids.size() && dense; ++i)
+			dense = ids[i - 1] != numeric_limits<VertexId>::max() && ids[i] == ids[i - 1] + 1;
+		if (dense) {
+			assign_dense(ids.empty() ? 0 : ids[0], ids.size());
+			return;
+		}
+
+		int bits = 1;
+		while ((size_t(1) << bits) < 2 * ids.size())
+			++bits;
+		shift = 64 - bits;
+		key.assign(size_t(1) << bits, 0);
+		value.assign(size_t(1) << bits, -1);
+		size_t mask = key.size() - 1;
+		for (size_t i = 0; i < ids.size(); ++i) {
+			size_t h = slot(ids[i]);
+			while (value[h] != -1 && key[h] != ids[i])
+				h = (h + 1) & mask;
+			key[h] = ids[i];
+			value[h] = i;
+		}
+	}
+
+	Index operator[](VertexId id) const {
+		if (value.empty())
+			return in_range(id, first, count) ? Index(id - first) : -1;
+		size_t mask = key.size() - 1;
+		for (size_t h = slot(id); value[h] != -1; h = (h + 1) & mask) {
+			if (key[h] == id)
+				return value[h];
+		}
+		return -1;
+	}
+};
+
+// first_vertex of files whose vertices keep their own numbers, see vertex_numbers
+const VertexId sparse_vertices = numeric_limits<VertexId>::min();
+
+// Numbers of the vertices of an edges file with N vertices: first_vertex ..
+// first_vertex + N - 1, any other number in the edges throws. With
+// sparse_vertices they are the numbers met in the edges in increasing
+// order instead, at most N of them.
+template <class Weight>
+vector<VertexId> vertex_numbers(const string & filename, int N, const vector<BasicEdge<VertexId, Weight>> & edges, VertexId first_vertex) {
+	vector<VertexId> vert;
+	if (first_vertex != sparse_vertices) {
+		for (auto & e : edges) {
+			if (!in_range(e.a, first_vertex, N) || !in_range(e.b, first_vertex, N))
+				throw runtime_error(filename + ": edge " + to_string(e.a) + " " + to_string(e.b)
+					+ " has a vertex out of " + to_string(first_vertex) + " .. " + to_string(first_vertex + N - 1));
+		}
+		vert.resize(N);
+		for (int v = 0; v < N; ++v)
+			vert[v] = v + first_vertex;
+		return vert;
+	}
+	vert.reserve(2 * edges.size());
+	for (auto & e : edges) {
+		vert.push_back(e.a);
+		vert.push_back(e.b);
+	}
+	sort(vert.begin(), vert.end());
+	vert.erase(unique(vert.begin(), vert.end()), vert.end());
+	if (vert.size() > size_t(N))
+		throw runtime_error(filename + ": more vertices than the " + to_string(N) + " declared");
+	return vert;
+}
+
+// Binary edges file, the graph of a text edges file stored ready to load:
+// the header, offset[N + 1] (uint64), then the arcs adj[M] (int32) grouped
+// by their first vertex, weight[M] (int64) if the file is weighted
+// (arcs of unweighted files get weight 1), and
+// id[N] (int64), the number of each vertex in the text file. Numbers are
+// in native byte order, vertices in adj are 0 .. N - 1.
+struct BinaryHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t flags;
+	int32_t n;
+	uint64_t m;
+};
+
+const char binary_magic[4] = { 'G', 'R', 'P', 'H' };
+const uint32_t binary_version = 3;
+const uint32_t binary_weighted = 1;
+
+// vertex v is numbered id[v], edges connect these numbers
+template <class Weight>
+void write_binary_edges_file(const string & filename, const vector<VertexId> & id, const vector<BasicEdge<VertexId, Weight>> & edges) {
+	const bool weighted = !is_same<Weight, Unweighted>::value;
+	int N = id.size();
+	VertexIndex<> index;
+	index.assign(id);
+	BinaryHeader h;
+	memcpy(h.magic, binary_magic, sizeof h.magic);
+	h.version = binary_version;
+	h.flags = weighted ? binary_weighted : 0;
+	h.n = N;
+	h.m = edges.size();
+
+	vector<uint64_t> offset(N + 1, 0);
+	for (auto & e : edges)
+		++offset[index[e.a] + 1];
+	for (int v = 0; v < N; ++v)
+		offset[v + 1] += offset[v];
+	vector<int32_t> adj(h.m);
+	vector<int64_t> weight(weighted ? h.m : 0);
+	vector<uint64_t> pos(offset.begin(), offset.end() - 1);
+	for (auto & e : edges) {
+		auto i = pos[index[e.a]]++;
+		adj[i] = index[e.b];
+		if (weighted)
+			weight[i] = edge_weight(e);
+	}
+
+	ofstream f(filename, ios::binary);
+	f.write((const char *)&h, sizeof h);
+	f.write((const char *)offset.data(), offset.size() * sizeof(uint64_t));
+	f.write((const char *)adj.data(), adj.size() * sizeof(int32_t));
+	f.write((const char *)weight.data(), weight.size() * sizeof(int64_t));
+	f.write((const char *)id.data(), id.size() * sizeof(int64_t));
+}
+
+// false if filename is not a binary edges file, throws if it is a damaged one;
+// the edges come grouped by their first vertex
+template <class Weight>
+bool read_binary_edges_file(const string & filename, int & N, vector<BasicEdge<VertexId, Weight>> & edges) {
+	typedef BasicEdge<VertexId, Weight> Edge;
+	const bool weighted = !is_same<Weight, Unweighted>::value;
+	ifstream f(filename, ios::binary);
+	BinaryHeader h;
+	if (!f.read((char *)&h, sizeof h) || memcmp(h.magic, binary_magic, sizeof h.magic) != 0)
+		return false;
+	if (h.version != binary_version)
+		throw runtime_error(filename + ": unsupported binary edges file version");
+
+	// the sizes in the header have to fit in what is left of the file
+	// before anything is allocated
+	auto start = f.tellg();
+	f.seekg(0, ios::end);
+	uint64_t left = uint64_t(f.tellg() - start);
+	f.seekg(start);
+	uint64_t arc_size = sizeof(int32_t) + ((h.flags & binary_weighted) ? sizeof(int64_t) : 0);
+	if (h.n < 0)
+		throw runtime_error(filename + ": negative number of vertices");
+	if (h.m > left / arc_size
+		|| (uint64_t(h.n) + 1) * sizeof(uint64_t) + uint64_t(h.n) * sizeof(int64_t) + h.m * arc_size > left)
+		throw runtime_error(filename + ": binary edges file is truncated");
+	auto read = [&](void * p, size_t bytes) {
+		if (!f.read((char *)p, bytes))
+			throw runtime_error(filename + ": binary edges file is truncated");
+	};
+
+	N = h.n;
+	vector<uint64_t> offset(size_t(N) + 1);
+	vector<int32_t> adj(h.m);
+	vector<int64_t> weight;
+	vector<int64_t> id(N);
+	read(offset.data(), offset.size() * sizeof(uint64_t));
+	read(adj.data(), adj.size() * sizeof(int32_t));
+	if (h.flags & binary_weighted) {
+		if (weighted) {
+			weight.resize(h.m);
+			read(weight.data(), weight.size() * sizeof(int64_t));
+		}
+		else if (!f.seekg(h.m * sizeof(int64_t), ios::cur)) {
+			throw runtime_error(filename + ": binary edges file is truncated");
+		}
+	}
+	read(id.data(), id.size() * sizeof(int64_t));
+
+	if (offset[0] != 0 || offset[N] != h.m)
+		throw runtime_error(filename + ": offsets do not cover the arcs");
+	for (int v = 0; v < N; ++v)
+		if (offset[v] > offset[v + 1])
+			throw runtime_error(filename + ": decreasing offsets");
+	for (auto b : adj)
+		if (b < 0 || b >= N)
+			throw runtime_error(filename + ": arc to a vertex out of range");
+
+	edges.resize(h.m);
+	for (int v = 0; v < N; ++v) {
+		for (auto i = offset[v]; i < offset[v + 1]; ++i)
+			edges[i] = Edge::make(id[v], id[adj[i]], weight.empty() ? 1 : weight[i]);
+	}
+	return true;
+}
+
+// Edges of a text or a binary edges file, the binary ones are told by their header.
+template <class Weight>
+vector<BasicEdge<VertexId, Weight>> load_edges_file(const string & filename, int & N) {
+	vector<BasicEdge<VertexId, Weight>> edges;
+	if (!read_binary_edges_file(filename, N, edges))
+		edges = read_edges_file<Weight>(filename, N);
+	return edges;
+}
+
+template <class Weight>
+void convert_edges_file(const string & text, const string & binary, VertexId first_vertex) {
+	int N;
+	auto edges = read_edges_file<Weight>(text, N);
+	write_binary_edges_file(binary, vertex_numbers(text, N, edges, first_vertex), edges);
+}
+
+// Sparse replacement of the dense adjacency matrix: a value for every pair
+// a -> b joined by an arc, stored only for such pairs. Unweighted graphs
+// keep the number of arcs, weighted ones the weight of the last arc added;
+// absent is what pairs without arcs give.
+template <class Index, class Value>
+class EdgeIndex {
+	// open addressing with linear probing, at most half of the slots
+	// are taken; key (-1, -1) marks a free slot
+	typedef pair<Index, Index> Key;
+	vector<Key> keys;
+	vector<Value> value;
+	Value absent;
+	size_t used = 0;
+	int shift = 64;
+
+	static Key free_key() {
+		return Key(-1, -1);
+	}
+
+	size_t slot(const Key & k) const {
+		unsigned long long x = (unsigned long long)k.first << 32 ^ (unsigned long long)k.second;
+		return size_t(x * 0x9E3779B97F4A7C15ull >> shift);
+	}
+
+	// slot of k, keys.size() if k is not stored
+	size_t find(const Key & k) const {
+		if (keys.empty())
+			return 0;
+		size_t mask = keys.size() - 1;
+		for (size_t h = slot(k); keys[h] != free_key(); h = (h + 1) & mask) {
+			if (keys[h] == k)
+				return h;
+		}
+		return keys.size();
+	}
+
+	// slot of k, taken for it if k was not stored
+	size_t place(const Key & k) {
+		if (2 * (used + 1) > keys.size())
+			grow();
+		size_t mask = keys.size() - 1;
+		size_t h = slot(k);
+		while (keys[h] != k && keys[h] != free_key())
+			h = (h + 1) & mask;
+		if (keys[h] != k) {
+			keys[h] = k;
+			value[h] = absent;
+			++used;
+		}
+		return h;
+	}
+
+	void grow() {
+		rehash(keys.empty() ? 4 : 65 - shift);
+	}
+
+	void rehash(int bits) {
+		vector<Key> old_keys(size_t(1) << bits, free_key());
+		vector<Value> old_value(size_t(1) << bits, absent);
+		old_keys.swap(keys);
+		old_value.swap(value);
+		shift = 64 - bits;
+		used = 0;
+		for (size_t i = 0; i < old_keys.size(); ++i) {
+			if (old_keys[i] != free_key())
+				value[place(old_keys[i])] = old_value[i];
+		}
+	}
+
+public:
+	explicit EdgeIndex(Value absent = Value()) : absent(absent) {}
+
+	// number of stored pairs
+	size_t size() const {
+		return used;
+	}
+
+	// makes room for n pairs at once
+	void reserve(size_t n) {
+		int bits = 4;
+		while ((size_t(1) << bits) < 2 * n)
+			++bits;
+		if ((size_t(1) << bits) > keys.size())
+			rehash(bits);
+	}
+
+	// calls f(a, b, value) for every stored pair, in no particular order
+	template <class F>
+	void for_each(F f) const {
+		for (size_t h = 0; h < keys.size(); ++h) {
+			if (keys[h] != free_key())
+				f(keys[h].first, keys[h].second, value[h]);
+		}
+	}
+
+	// counts one more arc a -> b
+	void add(Index a, Index b) {
+		++value[place(Key(a, b))];
+	}
+
+	void set(Index a, Index b, Value v) {
+		value[place(Key(a, b))] = v;
+	}
+
+	Value operator()(Index a, Index b) const {
+		size_t h = find(Key(a, b));
+		return h == keys.size() ? absent : value[h];
+	}
+
+	// all stored pairs with their values, ordered by a, then by b
+	vector<pair<BasicEdge<Index>, Value>> sorted() const {
+		vector<pair<Key, Value>> taken;
+		taken.reserve(used);
+		for (size_t h = 0; h < keys.size(); ++h) {
+			if (keys[h] != free_key())
+				taken.push_back({ keys[h], value[h] });
+		}
+		sort(taken.begin(), taken.end());
+		vector<pair<BasicEdge<Index>, Value>> res;
+		res.reserve(taken.size());
+		for (auto & el : taken)
+			res.push_back({ { el.first.first, el.first.second }, el.second });
+		return res;
+	}
+};
+
+// Compressed sparse row adjacency: neighbours of v are packed
+// in adj[offset[v]] .. adj[offset[v + 1] - 1].
+// Arcs are collected in a staging list and become visible after build(),
+// the order of neighbours is the order in which arcs were added.
+template <class Index>
+class CSR {
+	vector<Index> offset;
+	vector<Index> adj;
+	vector<BasicEdge<Index>> arcs;
+	Index N = 0;
+
+public:
+	struct Range {
+		const Index * first;
+		const Index * last;
+		const Index * begin() const { return first; }
+		const Index * end() const { return last; }
+		size_t size() const { return last - first; }
+		bool empty() const { return first == last; }
+		const Index & operator[](size_t i) const { return first[i]; }
+	};
+
+	void resize(Index N) {
+		this->N = N;
+		offset.assign(N + 1, 0);
+		adj.clear();
+		arcs.clear();
+	}
+
+	void add_arc(Index a, Index b) {
+		arcs.push_back({ a, b });
+	}
+
+	void build() {
+		if (arcs.empty())
+			return;
+		vector<Index> new_offset(N + 1, 0);
+		for (Index v = 0; v < N; ++v)
+			new_offset[v + 1] = offset[v + 1] - offset[v];
+		for (auto & e : arcs)
+			++new_offset[e.a + 1];
+		for (Index v = 0; v < N; ++v)
+			new_offset[v + 1] += new_offset[v];
+
+		vector<Index> new_adj(new_offset[N]);
+		vector<Index> pos(new_offset.begin(), new_offset.end() - 1);
+		for (Index v = 0; v < N; ++v)
+			for (Index i = offset[v]; i < offset[v + 1]; ++i)
+				new_adj[pos[v]++] = adj[i];
+		for (auto & e : arcs)
+			new_adj[pos[e.a]++] = e.b;
+
+		offset.swap(new_offset);
+		adj.swap(new_adj);
+		vector<BasicEdge<Index>>().swap(arcs);
+	}
+
+	// number of vertices
+	size_t size() const {
+		return N;
+	}
+
+	size_t arcs_number() const {
+		return adj.size();
+	}
+
+	Range operator[](Index v) const {
+		return { adj.data() + offset[v], adj.data() + offset[v + 1] };
+	}
+};
+
+// Weighted adjacency in compressed sparse row form, kept as separate arrays:
+// the arcs of v occupy positions offset[v] .. offset[v + 1] - 1 of target,
+// weight and edge, the latter holding the number of the arc's edge in e_list.
+// Scans over targets or weights read one contiguous array each.
+// Arcs are collected in a staging list and become visible after build(),
+// the order of arcs is the order in which they were added.
+template <class Index, class Weight>
+class WeightedCSR {
+	struct Arc {
+		Index a, b;
+		Weight w;
+		Index e;
+	};
+
+	vector<Index> offset;
+	vector<Index> target;
+	vector<Weight> weight;
+	vector<Index> edge;
+	vector<Arc> arcs;
+	Index N = 0;
+
+public:
+	// arcs of one vertex; iterating it yields the targets
+	struct Range {
+		const Index * target;
+		const Weight * weight;
+		const Index * edge;
+		size_t count;
+		const Index * begin() const { return target; }
+		const Index * end() const { return target + count; }
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		const Index & operator[](size_t i) const { return target[i]; }
+	};
+
+	void resize(Index N) {
+		this->N = N;
+		offset.assign(N + 1, 0);
+		target.clear();
+		weight.clear();
+		edge.clear();
+		arcs.clear();
+	}
+
+	// arc a -> b of weight w, coming from edge e of e_list; throws
+	// out_of_range if w does not fit in Weight, see weight_cast
+	template <class W>
+	void add_arc(Index a, Index b, W w, Index e) {
+		arcs.push_back({ a, b, weight_cast<Weight>(w), e });
+	}
+
+	void build() {
+		if (arcs.empty())
+			return;
+		vector<Index> new_offset(N + 1, 0);
+		for (Index v = 0; v < N; ++v)
+			new_offset[v + 1] = offset[v + 1] - offset[v];
+		for (auto & el : arcs)
+			++new_offset[el.a + 1];
+		for (Index v = 0; v < N; ++v)
+			new_offset[v + 1] += new_offset[v];
+
+		vector<Index> new_target(new_offset[N]);
+		vector<Weight> new_weight(new_offset[N]);
+		vector<Index> new_edge(new_offset[N]);
+		vector<Index> pos(new_offset.begin(), new_offset.end() - 1);
+		for (Index v = 0; v < N; ++v) {
+			for (Index i = offset[v]; i < offset[v + 1]; ++i) {
+				Index p = pos[v]++;
+				new_target[p] = target[i];
+				new_weight[p] = weight[i];
+				new_edge[p] = edge[i];
+			}
+		}
+		for (auto & el : arcs) {
+			Index p = pos[el.a]++;
+			new_target[p] = el.b;
+			new_weight[p] = el.w;
+			new_edge[p] = el.e;
+		}
+
+		offset.swap(new_offset);
+		target.swap(new_target);
+		weight.swap(new_weight);
+		edge.swap(new_edge);
+		vector<Arc>().swap(arcs);
+	}
+
+	// number of vertices
+	size_t size() const {
+		return N;
+	}
+
+	size_t arcs_number() const {
+		return target.size();
+	}
+
+	Range operator[](Index v) const {
+		Index first = offset[v];
+		return { target.data() + first, weight.data() + first, edge.data() + first, size_t(offset[v + 1] - first) };
+	}
+};
+
+// Fixed set of worker threads. run(f) calls f(t) once for every
+// t = 0 .. size() - 1, the calling thread being number 0, and waits
+// until all calls return. Jobs run from several threads at once are
+// executed one after another.
+class ThreadPool {
+	vector<thread> workers;
+	mutex busy;
+	mutex m;
+	condition_variable start, done;
+	const function<void(int)> * job = nullptr;
+	size_t generation = 0;
+	size_t pending = 0;
+	bool stop = false;
+
+	void work(int t) {
+		size_t seen = 0;
+		while (1) {
+			const function<void(int)> * f;
+			{
+				unique_lock<mutex> lock(m);
+				start.wait(lock, [&] { return stop || generation != seen; });
+				if (stop)
+					return;
+				seen = generation;
+				f = job;
+			}
+			(*f)(t);
+			lock_guard<mutex> lock(m);
+			if (--pending == 0)
+				done.notify_one();
+		}
+	}
+
+public:
+	explicit ThreadPool(int n) {
+		for (int t = 1; t < n; ++t)
+			workers.emplace_back([this, t] { work(t); });
+	}
+
+	~ThreadPool() {
+		{
+			lock_guard<mutex> lock(m);
+			stop = true;
+		}
+		start.notify_all();
+		for (auto & w : workers)
+			w.join();
+	}
+
+	int size() const {
+		return workers.size() + 1;
+	}
+
+	void run(const function<void(int)> & f) {
+		lock_guard<mutex> one_job(busy);
+		{
+			lock_guard<mutex> lock(m);
+			job = &f;
+			pending = workers.size();
+			++generation;
+		}
+		start.notify_all();
+		f(0);
+		unique_lock<mutex> lock(m);
+		done.wait(lock, [&] { return pending == 0; });
+	}
+};
+
+// Relaxed atomic operations on plain int or long long slots, so that the
+// arrays shared by the threads stay ordinary vectors.
+
+template <class T>
+inline T load_relaxed(const T & slot) {
+#ifdef _MSC_VER
+	return *(const volatile T *)&slot;
+#else
+	return __atomic_load_n(&slot, __ATOMIC_RELAXED);
+#endif
+}
+
+template <class T>
+inline void store_relaxed(T & slot, T value) {
+#ifdef _MSC_VER
+	*(volatile T *)&slot = value;
+#else
+	__atomic_store_n(&slot, value, __ATOMIC_RELAXED);
+#endif
+}
+
+template <class T>
+inline bool compare_and_swap(T & slot, T expected, T value) {
+#ifdef _MSC_VER
+	if (sizeof(T) == sizeof(long long))
+		return _InterlockedCompareExchange64((volatile long long *)&slot, value, expected) == expected;
+	return _InterlockedCompareExchange((volatile long *)&slot, long(value), long(expected)) == long(expected);
+#else
+	return __atomic_compare_exchange_n(&slot, &expected, value, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+#endif
+}
+
+// Atomically changes slot from -1 to value, false if it was already taken
+template <class T>
+inline bool claim(T & slot, T value) {
+	return load_relaxed(slot) == -1 && compare_and_swap(slot, T(-1), value);
+}
+
+// Atomically adds delta to slot, returns the new value
+template <class T>
+inline T add_relaxed(T & slot, T delta) {
+#ifdef _MSC_VER
+	T cur = load_relaxed(slot);
+	while (!compare_and_swap(slot, cur, T(cur + delta)))
+		cur = load_relaxed(slot);
+	return cur + delta;
+#else
+	return __atomic_add_fetch(&slot, delta, __ATOMIC_RELAXED);
+#endif
+}
+
+// Atomically increases slot by one
+template <class T>
+inline void increment(T & slot) {
+	add_relaxed(slot, T(1));
+}
+
+// Atomically decreases slot by one, returns the new value
+template <class T>
+inline T decrement(T & slot) {
+	return add_relaxed(slot, T(-1));
+}
+
+// Atomically raises slot to value, false if it was not below value
+template <class T>
+inline bool raise_to(T & slot, T value) {
+	T cur = load_relaxed(slot);
+	while (cur < value) {
+		if (compare_and_swap(slot, cur, value))
+			return true;
+		cur = load_relaxed(slot);
+	}
+	return false;
+}
+
+// Components in flat form: id[v] is the component of vertex v, vertices of
+// component c are vert[offset[c]] .. vert[offset[c + 1] - 1] in increasing
+// order. How components are numbered is told by the query returning them.
+template <class Index>
+struct Components {
+	vector<Index> id;
+	vector<Index> offset;
+	vector<Index> vert;
+
+	size_t size() const {
+		return offset.size() - 1;
+	}
+
+	size_t size(Index c) const {
+		return offset[c + 1] - offset[c];
+	}
+
+	const Index * begin(Index c) const {
+		return vert.data() + offset[c];
+	}
+
+	const Index * end(Index c) const {
+		return vert.data() + offset[c + 1];
+	}
+
+	Index largest() const {
+		Index res = 0;
+		for (size_t c = 1; c < size(); ++c) {
+			if (size(c) > size(res))
+				res = c;
+		}
+		return res;
+	}
+};
+
+// Layers of a directed graph: layer k holds the vertices whose longest
+// path from a source has k arcs, as vert[offset[k]] .. vert[offset[k + 1] - 1]
+// in increasing order, so vert is also a topological order. Vertices on
+// or behind a cycle belong to no layer; cycle is then one such cycle
+// v0 -> v1 -> ... -> v0, without repeating v0.
+template <class Index>
+struct Layers {
+	vector<Index> offset;
+	vector<Index> vert;
+	vector<Index> cycle;
+
+	size_t size() const {
+		return offset.size() - 1;
+	}
+
+	const Index * begin(Index k) const {
+		return vert.data() + offset[k];
+	}
+
+	const Index * end(Index k) const {
+		return vert.data() + offset[k + 1];
+	}
+
+	bool acyclic() const {
+		return cycle.empty();
+	}
+};
+
+// Tree as parent links: parent(v) is the vertex v was reached from, -1 for
+// the root and for unreached vertices; weight(v) is the weight of the arc
+// parent(v) -> v in a weighted tree. Children of v are begin(v) .. end(v) - 1
+// in increasing order, counted out of the links on the first request.
+template <class Index, class Weight = Unweighted>
+class SpanningTree {
+	vector<Index> link;
+	vector<Weight> w;
+	mutable vector<Index> offset;
+	mutable vector<Index> child;
+
+	void build_children() const {
+		if (!offset.empty())
+			return;
+		Index n = link.size();
+		offset.assign(n + 1, 0);
+		for (Index v = 0; v < n; ++v)
+			if (link[v] >= 0)
+				++offset[link[v] + 1];
+		for (Index v = 0; v < n; ++v)
+			offset[v + 1] += offset[v];
+		child.resize(offset[n]);
+		vector<Index> pos(offset.begin(), offset.end() - 1);
+		for (Index v = 0; v < n; ++v)
+			if (link[v] >= 0)
+				child[pos[link[v]]++] = v;
+	}
+
+	static void print_child(ostream & s, VertexId name, Unweighted) {
+		s << name << " ";
+	}
+
+	template <class W>
+	static void print_child(ostream & s, VertexId name, W weight) {
+		s << name << "(" << weight << ") ";
+	}
+
+public:
+	SpanningTree() {}
+
+	explicit SpanningTree(vector<Index> parent, vector<Weight> weight = {}) : link(move(parent)), w(move(weight)) {}
+
+	size_t N() const {
+		return link.size();
+	}
+
+	Index parent(Index v) const {
+		return link[v];
+	}
+
+	Weight weight(Index v) const {
+		return w.empty() ? Weight() : w[v];
+	}
+
+	size_t edges_number() const {
+		build_children();
+		return child.size();
+	}
+
+	const Index * begin(Index v) const {
+		build_children();
+		return child.data() + offset[v];
+	}
+
+	const Index * end(Index v) const {
+		build_children();
+		return child.data() + offset[v + 1];
+	}
+
+	// vertices are printed as name[v], vertices and children by increasing
+	// name, so a tree of a reordered graph prints the same; with
+	// skip_isolated only the vertices that have children
+	void print_adjacency_list(ostream & s, const vector<VertexId> & name, bool skip_isolated = false) const {
+		auto by_name = [&](Index a, Index b) { return name[a] < name[b]; };
+		vector<Index> order(N());
+		for (size_t i = 0; i < N(); ++i)
+			order[i] = i;
+		sort(order.begin(), order.end(), by_name);
+		vector<Index> ch;
+		s << "Adjacency list:\n";
+		for (auto i : order) {
+			if (skip_isolated && begin(i) == end(i))
+				continue;
+			s << name[i] << ": ";
+			ch.assign(begin(i), end(i));
+			sort(ch.begin(), ch.end(), by_name);
+			for (auto el : ch)
+				print_child(s, name[el], weight(el));
+			s << "\n";
+		}
+		s << "\n";
+	}
+};
+
+// Visited marks and predecessors reused between traversals. A vertex is
+// visited only if its stamp equals the current epoch, so a new traversal
+// starts in O(1) and pays only for the vertices it reaches.
+template <class Index>
+class Workspace {
+	vector<int> stamp;
+	vector<Index> pred;
+	vector<Index> reached;
+	int epoch = 0;
+
+public:
+	void start(size_t n) {
+		if (stamp.size() != n || epoch == numeric_limits<int>::max()) {
+			stamp.assign(n, 0);
+			pred.resize(n);
+			epoch = 0;
+		}
+		++epoch;
+		reached.clear();
+	}
+
+	bool visited(Index v) const {
+		return stamp[v] == epoch;
+	}
+
+	void visit(Index v, Index p) {
+		stamp[v] = epoch;
+		pred[v] = p;
+		reached.push_back(v);
+	}
+
+	// Concurrent version of visit, false if v is already visited.
+	// The caller adds claimed vertices to vertices() itself.
+	bool claim(Index v, Index p) {
+		int s = load_relaxed(stamp[v]);
+		if (s == epoch || !compare_and_swap(stamp[v], s, epoch))
+			return false;
+		pred[v] = p;
+		return true;
+	}
+
+	// predecessor of a visited vertex, -1 for the others
+	Index parent(Index v) const {
+		return visited(v) ? pred[v] : -1;
+	}
+
+	// visited vertices in order of visiting
+	vector<Index> & vertices() {
+		return reached;
+	}
+};
+
+// Adjacency lists packed to save memory: every list is sorted and kept as
+// the gaps between consecutive neighbours (the first one counted from 0) in
+// varints of 7 bits per byte, so most arcs take one or two bytes instead
+// of four. Lists are decoded on the fly by a forward iterator. The degree
+// of a vertex is the varint in front of its list, next to the bytes a
+// search reads anyway.
+template <class Index>
+class PackedAdjList {
+	typedef typename make_unsigned<Index>::type Gap;
+
+	vector<unsigned long long> offset;
+	vector<unsigned char> bytes;
+	size_t arcs = 0;
+
+	static const unsigned char * decode(const unsigned char * p, Gap & x) {
+		unsigned char b;
+		int shift = 0;
+		x = 0;
+		do {
+			b = *p++;
+			x |= Gap(b & 127) << shift;
+			shift += 7;
+		} while (b & 128);
+		return p;
+	}
+
+	void encode(Gap x) {
+		while (x >= 128) {
+			bytes.push_back((unsigned char)(x | 128));
+			x >>= 7;
+		}
+		bytes.push_back((unsigned char)x);
+	}
+
+public:
+	// Decodes one varint ahead. The one after the end of a list belongs to
+	// the next list or is the closing zero byte, so it is always there.
+	class iterator {
+		const unsigned char * cur;
+		const unsigned char * next;
+		Index value;
+
+	public:
+		iterator(const unsigned char * p) : cur(p), next(p), value(0) {}
+
+		iterator(const unsigned char * p, Index first) : cur(p) {
+			Gap gap;
+			next = decode(p, gap);
+			value = first + gap;
+		}
+
+		Index operator*() const {
+			return value;
+		}
+
+		iterator & operator++() {
+			Gap gap;
+			cur = next;
+			next = decode(cur, gap);
+			value += gap;
+			return *this;
+		}
+
+		bool operator==(const iterator & it) const {
+			return cur == it.cur;
+		}
+
+		bool operator!=(const iterator & it) const {
+			return cur != it.cur;
+		}
+	};
+
+	struct Range {
+		iterator first;
+		iterator last;
+		Gap count;
+		iterator begin() const { return first; }
+		iterator end() const { return last; }
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+	};
+
+	PackedAdjList() {}
+
+	// packs lists adj[0] .. adj[n - 1]
+	template <class Adj>
+	PackedAdjList(const Adj & adj, Index n) {
+		offset.assign(n + 1, 0);
+		vector<Index> list;
+		for (Index v = 0; v < n; ++v) {
+			list.assign(adj[v].begin(), adj[v].end());
+			sort(list.begin(), list.end());
+			arcs += list.size();
+			encode(list.size());
+			Index prev = 0;
+			for (auto u : list) {
+				encode(u - prev);
+				prev = u;
+			}
+			offset[v + 1] = bytes.size();
+		}
+		bytes.push_back(0);
+		bytes.shrink_to_fit();
+	}
+
+	size_t size() const {
+		return offset.empty() ? 0 : offset.size() - 1;
+	}
+
+	size_t arcs_number() const {
+		return arcs;
+	}
+
+	Range operator[](Index v) const {
+		auto p = bytes.data();
+		Gap count;
+		auto first = decode(p + offset[v], count);
+		return { iterator(first, 0), iterator(p + offset[v + 1]), count };
+	}
+
+	// bytes taken by the lists
+	size_t memory() const {
+		return offset.size() * sizeof(offset[0]) + bytes.size();
+	}
+};
+
+// Set of BFS sources carried by one sweep, one bit per source.
+// Several words per mask let the compiler process them as one SIMD register.
+struct SourceMask {
+	typedef unsigned long long Word;
+	static const int WORD_BITS = 64;
+	static const int LANES = 4;
+	static const int WIDTH = WORD_BITS * LANES;
+
+	Word w[LANES];
+
+	void clear() {
+		for (int l = 0; l < LANES; ++l)
+			w[l] = 0;
+	}
+
+	void set(int k) {
+		w[k / WORD_BITS] |= Word(1) << (k % WORD_BITS);
+	}
+
+	static int lowest_bit(Word m) {
+#if defined(_MSC_VER) && defined(_WIN64)
+		unsigned long i;
+		_BitScanForward64(&i, m);
+		return i;
+#elif defined(_MSC_VER)
+		unsigned long i;
+		if (_BitScanForward(&i, (unsigned long)m))
+			return i;
+		_BitScanForward(&i, (unsigned long)(m >> 32));
+		return i + 32;
+#else
+		return __builtin_ctzll(m);
+#endif
+	}
+
+	bool empty() const {
+		Word r = 0;
+		for (int l = 0; l < LANES; ++l)
+			r |= w[l];
+		return r == 0;
+	}
+};
+
+template <class Index>
+class DSU {
+	vector<Index> parent;
+public:
+	DSU() {}
+
+	DSU(Index n) {
+		reset(n);
+	}
+
+	// n single sets, the memory is kept
+	void reset(Index n) {
+		parent.resize(n);
+		for (Index v = 0; v < n; ++v)
+			parent[v] = v;
+	}
+
+	Index find_set(Index v) {
+		if (v == parent[v])
+			return v;
+		return parent[v] = find_set(parent[v]);
+	}
+
+	void union_sets(Index a, Index b) {
+		a = find_set(a);
+		b = find_set(b);
+		if (a != b)
+			parent[b] = a;
+	}
+};
+
+// Scratch state of one querying thread. Queries do not modify a Graph,
+// so one graph can serve any number of threads, each with its own Context.
+template <class Index, class Weight>
+struct BasicContext {
+	// vertex x reached at distance w, the closest on top of a heap
+	struct Pr {
+		Index x;
+		Weight w;
+		bool operator< (const Pr & p) const {
+			return w > p.w;
+		}
+	};
+
+	// sources, marks and frontiers of one multi_bfs sweep
+	struct Sweep {
+		vector<SourceMask> seen, cur, next;
+		vector<Index> front, next_front;
+	};
+
+	Workspace<Index> ws;
+	vector<pair<Index, const Index *>> frames;
+	vector<pair<Index, typename PackedAdjList<Index>::iterator>> packed_frames;
+	vector<VertexId> num;
+	// frontiers of the breadth-first searches, the lists filled by the
+	// threads of the pool and the frontier bitmap of bottom-up steps
+	vector<Index> front;
+	vector<Index> next;
+	vector<vector<Index>> local;
+	vector<unsigned long long> front_bits;
+	// in-degrees and layers of get_layering, labels of parallel_scc
+	vector<Index> count;
+	vector<Index> layer;
+	// one per thread of get_accessability
+	vector<Sweep> sweeps;
+	// state of get_strong_components, see scc_dfs
+	vector<Index> rindex;
+	vector<char> root;
+	vector<Index> open;
+	// state of the spanning tree and shortest paths queries; the work
+	// lists keep their capacity, so repeated queries do not allocate
+	vector<Index> pred;
+	vector<Index> component;
+	vector<Index> min_edge;
+	vector<BasicEdge<Index, Weight>> heap;
+	vector<Weight> d;
+	vector<Pr> bag;
+	DSU<Index> dsu;
+
+	// DFS stack for the kind of lists the search runs on
+	template <class Adj>
+	auto & frames_for(const Adj &) { return frames; }
+	auto & frames_for(const PackedAdjList<Index> &) { return packed_frames; }
+};
+
+// Direction policies of Graph: a Directed graph stores every edge
+// as one arc, an Undirected graph as two opposite arcs.
+struct Directed {
+	static const bool oriented = true;
+};
+
+struct Undirected {
+	static const bool oriented = false;
+};
+
+// Graph on vertices 0 .. N() - 1 of type IndexT, vertex v being number
+// vert_original[v] of the edges file. WeightT is the type of edge weights,
+// Unweighted for graphs without them. Edges are added to e_list at once and
+// to the adjacency lists on the next build().
+template <class Direction, class WeightT = Unweighted, class IndexT = int>
+class Graph {
+	static_assert(is_integral<IndexT>::value && is_signed<IndexT>::value && sizeof(IndexT) >= sizeof(int),
+		"vertex indices are signed integers of at least int size");
+
+public:
+	static const bool oriented = Direction::oriented;
+	static const bool weighted = !is_same<WeightT, Unweighted>::value;
+
+	typedef WeightT Weight;
+	typedef IndexT Index;
+	typedef BasicEdge<Index, Weight> Edge;
+	typedef vector<Edge> EdgesList;
+	typedef typename conditional<weighted, WeightedCSR<Index, Weight>, CSR<Index>>::type AdjList;
+	// what e_index keeps for a pair of vertices, see EdgeIndex
+	typedef typename conditional<weighted, Weight, int>::type ArcValue;
+	typedef vector<vector<ArcValue>> AdjMatrix;
+	typedef BasicContext<Index, Weight> Context;
+
+	vector<VertexId> vert_original;
+	VertexIndex<Index> vert_index;
+	EdgesList e_list;
+	AdjList a_list;
+	CSR<Index> in_list; // reversed a_list of an oriented graph, see build_in_list
+	PackedAdjList<Index> packed_list; // a_list and in_list after pack()
+	PackedAdjList<Index> packed_in_list;
+	// value of every pair joined by arcs, see arc_value and sorted_arcs;
+	// e_list and e_index are empty in a packed graph
+	EdgeIndex<Index, ArcValue> e_index = EdgeIndex<Index, ArcValue>(no_arc());
+
+	// what e_index gives for a pair without arcs: 0 or, in a weighted
+	// graph, the largest weight
+	static ArcValue no_arc() {
+		return weighted ? numeric_limits<ArcValue>::max() : ArcValue();
+	}
+
+	static Weight infinity() {
+		return numeric_limits<Weight>::max();
+	}
+
+public:
+	size_t N() const {
+		return vert_original.size();
+	}
+
+	void add_edge(const Edge & e) {
+		if (packed())
+			throw logic_error("add_edge: the graph is packed");
+		Index i = e_list.size();
+		e_list.push_back(e);
+		add_arc(a_list, e.a, e.b, e, i);
+		if (!oriented)
+			add_arc(a_list, e.b, e.a, e, i);
+		else if (in_list.size() == N())
+			in_list.add_arc(e.b, e.a);
+
+		index_arc(e.a, e.b, e);
+		if (!oriented && e.a != e.b)
+			index_arc(e.b, e.a, e);
+	}
+
+	// of weight 1 in a weighted graph, like the arcs of unweighted files
+	void add_edge(Index x, Index y) {
+		add_edge(Edge::make(x, y, 1));
+	}
+
+	template <class W>
+	void add_edge(Index x, Index y, W w) {
+		add_edge(Edge::make(x, y, w));
+	}
+
+	// vertices first .. first + N - 1
+	void init(Index N, VertexId first = 1) {
+		vert_index.assign_dense(first, N);
+		vert_original.resize(N);
+		for (Index i = 0; i < N; ++i)
+			vert_original[i] = i + first;
+		a_list.resize(N);
+	}
+
+	// makes edges added since the last call visible to queries
+	void build() {
+		a_list.build();
+		in_list.build();
+	}
+
+	// Reversed adjacency of an oriented graph for bottom-up BFS steps and
+	// searches along predecessors, once built add_edge keeps it up to date.
+	// An undirected graph is its own reverse and needs none.
+	void build_in_list() {
+		if (!oriented)
+			return;
+		build();
+		Index n = N();
+		CSR<Index> in;
+		in.resize(n);
+		with_lists([&](const auto & out, const auto &) {
+			for (Index v = 0; v < n; ++v)
+				for (auto u : out[v])
+					in.add_arc(u, v);
+		});
+		in.build();
+		if (packed())
+			packed_in_list = PackedAdjList<Index>(in, n);
+		else
+			in_list = move(in);
+	}
+
+	// Replaces the graph with packed copies of a_list and in_list to save
+	// memory; e_list and e_index are dropped too. Everything runs on the
+	// packed lists afterwards, visiting neighbours in increasing order:
+	// edges and pairs of vertices are read back from them, see for_each_edge
+	// and sorted_arcs. Edges can no longer be added. Packed lists keep no weights.
+	void pack() {
+		static_assert(!weighted, "pack: packed lists keep no weights");
+		if (packed())
+			return;
+		build();
+		packed_list = PackedAdjList<Index>(a_list, N());
+		if (oriented && in_list.size() == N())
+			packed_in_list = PackedAdjList<Index>(in_list, N());
+		a_list = AdjList();
+		in_list = CSR<Index>();
+		EdgesList().swap(e_list);
+		e_index = EdgeIndex<Index, ArcValue>(no_arc());
+	}
+
+	bool packed() const {
+		return a_list.size() != N();
+	}
+
+	// Calls f(out, in) with the lists traversals run on, packed or not;
+	// in is out itself in an undirected graph and has size() != N() in an
+	// oriented one without in_list.
+	template <class F>
+	void with_lists(F f) const {
+		with_lists(f, integral_constant<bool, weighted>());
+	}
+
+	// vertices of an edges file, see vertex_numbers
+	template <class W>
+	void init_vertices(const string & filename, int N, const vector<BasicEdge<VertexId, W>> & edges, VertexId first_vertex) {
+		vert_original = vertex_numbers(filename, N, edges, first_vertex);
+		vert_index.assign(vert_original);
+		a_list.resize(vert_original.size());
+	}
+
+	Graph() {
+
+	}
+
+	explicit Graph(Index N, VertexId first = 1) {
+		init(N, first);
+	}
+
+	Graph(const vector<VertexId> & vert_original, const VertexIndex<Index> & vert_index) {
+		this->vert_index = vert_index;
+		this->vert_original = vert_original;
+		a_list.resize(N());
+	}
+
+	// the vertices vert of an edges file, edges to other vertices are dropped
+	Graph(const string & filename, const vector<VertexId> & vert) {
+		//constructing edges list
+		int N;
+		auto edges = load_edges_file<FileWeight>(filename, N);
+		vert_original = vert;
+		vert_index.assign(vert);
+		a_list.resize(vert.size());
+
+		try {
+			for (auto & e : edges) {
+				Index a = vert_index[e.a];
+				Index b = vert_index[e.b];
+				if (a != -1 && b != -1)
+					add_edge(a, b, edge_weight(e));
+			}
+		}
+		catch (out_of_range &) {
+			throw runtime_error(filename + ": weight out of range");
+		}
+		build();
+		build_in_list();
+	}
+
+	// vertices of the file are numbered from first_vertex, see vertex_numbers
+	explicit Graph(const string & filename, VertexId first_vertex = 1) {
+		//constructing edges list
+		int N;
+		auto edges = load_edges_file<FileWeight>(filename, N);
+		init_vertices(filename, N, edges, first_vertex);
+
+		try {
+			for (auto & e : edges)
+				add_edge(vert_index[e.a], vert_index[e.b], edge_weight(e));
+		}
+		catch (out_of_range &) {
+			throw runtime_error(filename + ": weight out of range");
+		}
+		build();
+		build_in_list();
+	}
+
+	// simple graph on the same vertices: one edge for every pair joined by
+	// an edge, with the weight added last in a weighted graph; loops are dropped
+	Graph get_regular_graph() const {
+		Graph g(vert_original, vert_index);
+		for (auto & el : sorted_arcs()) {
+			if (el.first.a != el.first.b && (oriented || el.first.a < el.first.b))
+				g.add_edge(el.first.a, el.first.b, el.second);
+		}
+		g.build();
+		return g;
+	}
+
+	// Subgraph induced by the vertices vert (original numbers), built in
+	// one pass over the edges; vertices are renumbered in the order of vert.
+	Graph get_induced_subgraph(const vector<VertexId> & vert) const {
+		Graph g;
+		g.vert_original = vert;
+		g.vert_index.assign(vert);
+		g.a_list.resize(vert.size());
+
+		for_each_edge([&](Edge e) {
+			e.a = g.vert_index[vert_original[e.a]];
+			e.b = g.vert_index[vert_original[e.b]];
+			if (e.a != -1 && e.b != -1)
+				g.add_edge(e);
+		});
+		g.build();
+		g.build_in_list();
+		return g;
+	}
+
+	// Calls f(e) for every edge: the ones of e_list or, in a packed graph,
+	// the ones read back from the lists by their first vertex, an edge of
+	// an undirected graph once with a <= b.
+	template <class F>
+	void for_each_edge(F f) const {
+		if (!packed()) {
+			for (auto & e : e_list)
+				f(e);
+			return;
+		}
+		with_lists([&](const auto & out, const auto &) {
+			for (size_t v = 0; v < N(); ++v) {
+				bool first_end = false; // a loop is listed at both of its ends
+				for (Index u : out[v]) {
+					if (oriented || Index(v) < u)
+						f(Edge::make(v, u, 1));
+					else if (Index(v) == u && (first_end = !first_end))
+						f(Edge::make(v, u, 1));
+				}
+			}
+		});
+	}
+
+	// what e_index keeps for the pair a -> b, no_arc() if there are no arcs
+	ArcValue arc_value(Index a, Index b) const {
+		if (!packed())
+			return e_index(a, b);
+		ArcValue res = ArcValue();
+		with_lists([&](const auto & out, const auto &) {
+			for (auto u : out[a])
+				res += u == b;
+		});
+		// a loop of an undirected graph is counted once
+		return !oriented && a == b ? res / 2 : res;
+	}
+
+	// every pair a -> b joined by arcs with its arc_value, ordered by a, then by b
+	vector<pair<BasicEdge<Index>, ArcValue>> sorted_arcs() const {
+		if (!packed())
+			return e_index.sorted();
+		vector<pair<BasicEdge<Index>, ArcValue>> res;
+		with_lists([&](const auto & out, const auto &) {
+			for (size_t v = 0; v < N(); ++v) {
+				const size_t none = numeric_limits<size_t>::max();
+				size_t loop = none;
+				for (Index u : out[v]) {
+					if (!res.empty() && res.back().first.a == Index(v) && res.back().first.b == u)
+						++res.back().second;
+					else
+						res.push_back({ { Index(v), u }, 1 });
+					if (u == Index(v))
+						loop = res.size() - 1;
+				}
+				// a loop of an undirected graph is listed at both of its ends
+				if (!oriented && loop != none)
+					res[loop].second /= 2;
+			}
+		});
+		return res;
+	}
+
+	// number of arcs out of x
+	size_t degree(Index x) const {
+		size_t d = 0;
+		with_lists([&](const auto & out, const auto &) { d = out[x].size(); });
+		return d;
+	}
+
+	// number of arcs into x, counted over all lists without in_list
+	size_t in_degree(Index x) const {
+		size_t d = 0;
+		with_lists([&](const auto & out, const auto & in) {
+			if (in.size() == N()) {
+				d = in[x].size();
+				return;
+			}
+			for (size_t v = 0; v < N(); ++v)
+				for (auto u : out[v])
+					d += u == x;
+		});
+		return d;
+	}
+
+	// Vertex orders for get_reordered: order[i] is the vertex to become
+	// vertex i. Arcs are followed as stored, so in an oriented graph only
+	// along their direction.
+
+	// by decreasing number of neighbours, hubs first
+	vector<Index> degree_order() const {
+		vector<Index> order(N());
+		for (size_t v = 0; v < N(); ++v)
+			order[v] = v;
+		with_lists([&](const auto & out, const auto &) {
+			stable_sort(order.begin(), order.end(), [&](Index x, Index y) {
+				return out[x].size() > out[y].size();
+			});
+		});
+		return order;
+	}
+
+	// BFS from every vertex not reached yet, neighbours in the order of
+	// the lists; with lowest_degree_first neighbours come by increasing degree
+	// and every search starts at a vertex of the lowest degree (Cuthill-McKee)
+	vector<Index> bfs_order(bool lowest_degree_first = false) const {
+		vector<Index> order;
+		order.reserve(N());
+		vector<bool> used(N());
+		vector<Index> starts(N());
+		for (size_t v = 0; v < N(); ++v)
+			starts[v] = v;
+		with_lists([&](const auto & out, const auto &) {
+			auto by_degree = [&](Index x, Index y) {
+				return out[x].size() < out[y].size();
+			};
+			if (lowest_degree_first)
+				stable_sort(starts.begin(), starts.end(), by_degree);
+
+			vector<Index> next;
+			for (auto s : starts) {
+				if (used[s])
+					continue;
+				used[s] = true;
+				order.push_back(s);
+				for (size_t head = order.size() - 1; head < order.size(); ++head) {
+					Index v = order[head];
+					next.clear();
+					for (auto el : out[v]) {
+						if (!used[el]) {
+							used[el] = true;
+							next.push_back(el);
+						}
+					}
+					if (lowest_degree_first)
+						stable_sort(next.begin(), next.end(), by_degree);
+					order.insert(order.end(), next.begin(), next.end());
+				}
+			}
+		});
+		return order;
+	}
+
+	// by increasing vert_original, undoes a reordering for printing
+	vector<Index> number_order() const {
+		vector<Index> order(N());
+		for (size_t v = 0; v < N(); ++v)
+			order[v] = v;
+		sort(order.begin(), order.end(), [&](Index x, Index y) {
+			return vert_original[x] < vert_original[y];
+		});
+		return order;
+	}
+
+	// reverse Cuthill-McKee, keeps neighbours close in the numbering
+	vector<Index> rcm_order() const {
+		auto order = bfs_order(true);
+		reverse(order.begin(), order.end());
+		return order;
+	}
+
+	// Copy of the graph with vertex order[i] renumbered to i. Vertex numbers
+	// go with the vertices, so prints and reports show the same numbers;
+	// adjacency lists keep their order. The copy of a packed graph is not
+	// packed, its lists come in increasing order.
+	Graph get_reordered(const vector<Index> & order) const {
+		vector<Index> pos(N());
+		vector<VertexId> vo(N());
+		for (size_t i = 0; i < N(); ++i) {
+			pos[order[i]] = i;
+			vo[i] = vert_original[order[i]];
+		}
+		VertexIndex<Index> vi;
+		vi.assign(vo);
+
+		Graph g(vo, vi);
+		g.e_list.reserve(e_list.size());
+		for_each_edge([&](Edge e) {
+			e.a = pos[e.a];
+			e.b = pos[e.b];
+			g.e_list.push_back(e);
+		});
+		bool has_in = false;
+		with_lists([&](const auto & out, const auto & in) {
+			for (size_t i = 0; i < N(); ++i)
+				copy_arcs(g.a_list, i, out[order[i]], pos);
+			has_in = in.size() == N();
+		});
+		g.build();
+		if (packed()) {
+			for (auto & e : g.e_list) {
+				g.index_arc(e.a, e.b, e);
+				if (!oriented && e.a != e.b)
+					g.index_arc(e.b, e.a, e);
+			}
+		}
+		else {
+			g.e_index.reserve(e_index.size());
+			e_index.for_each([&](Index a, Index b, ArcValue v) { g.e_index.set(pos[a], pos[b], v); });
+		}
+		if (has_in)
+			g.build_in_list();
+		return g;
+	}
+
+	// dense matrix is built only on request, mind O(N^2) memory
+	AdjMatrix get_adjacency_matrix() const {
+		AdjMatrix a_mtx(N(), vector<ArcValue>(N(), no_arc()));
+		for (auto & el : sorted_arcs())
+			a_mtx[el.first.a][el.first.b] = el.second;
+		return a_mtx;
+	}
+
+	void print_adjacency_matrix(ostream & s) const {
+		s << "Adjacency matrix:\n";
+		for (auto & v : get_adjacency_matrix()) {
+			for (auto & el : v)
+				s << (el == no_arc() ? ArcValue() : el) << " ";
+			s << "\n";
+		}
+		s << "\n";
+	}
+	void print_adjacency_list(ostream & s, bool skip_isolated = false) const {
+		with_lists([&](const auto & out, const auto &) { print_lists(s, out, skip_isolated); });
+	}
+
+	// the vertices with only the given edges, such as a spanning tree
+	void print_adjacency_list(ostream & s, const EdgesList & edges) const {
+		AdjList adj;
+		adj.resize(N());
+		for (size_t i = 0; i < edges.size(); ++i) {
+			add_arc(adj, edges[i].a, edges[i].b, edges[i], i);
+			if (!oriented)
+				add_arc(adj, edges[i].b, edges[i].a, edges[i], i);
+		}
+		adj.build();
+		print_lists(s, adj, false);
+	}
+
+private:
+	// weight type of the edges files, narrowed to Weight by add_edge
+	typedef typename conditional<weighted, long long, Unweighted>::type FileWeight;
+
+	shared_ptr<ThreadPool> pool;
+
+	static void add_arc(CSR<Index> & adj, Index a, Index b, const Edge &, Index) {
+		adj.add_arc(a, b);
+	}
+
+	static void add_arc(WeightedCSR<Index, Weight> & adj, Index a, Index b, const Edge & e, Index i) {
+		adj.add_arc(a, b, e.w, i);
+	}
+
+	void index_arc(Index a, Index b, const Edge & e) {
+		index_arc(a, b, e, integral_constant<bool, weighted>());
+	}
+
+	void index_arc(Index a, Index b, const Edge &, false_type) {
+		e_index.add(a, b);
+	}
+
+	void index_arc(Index a, Index b, const Edge & e, true_type) {
+		e_index.set(a, b, e.w);
+	}
+
+	// arcs of vertex v of the copy, see get_reordered
+	template <class Range>
+	static void copy_arcs(CSR<Index> & adj, Index v, const Range & arcs, const vector<Index> & pos) {
+		for (auto u : arcs)
+			adj.add_arc(v, pos[u]);
+	}
+
+	static void copy_arcs(WeightedCSR<Index, Weight> & adj, Index v, const typename WeightedCSR<Index, Weight>::Range & arcs, const vector<Index> & pos) {
+		for (size_t j = 0; j < arcs.size(); ++j)
+			adj.add_arc(v, pos[arcs.target[j]], arcs.weight[j], arcs.edge[j]);
+	}
+
+	template <class Adj>
+	void print_lists(ostream & s, const Adj & out, bool skip_isolated) const {
+		s << "Adjacency list:\n";
+		for (size_t i = 0; i < N(); ++i) {
+			if (skip_isolated && out[i].empty())
+				continue;
+			s << vert_original[i] << ": ";
+			print_arcs(s, out[i]);
+			s << "\n";
+		}
+		s << "\n";
+	}
+
+	template <class Range>
+	void print_arcs(ostream & s, const Range & arcs) const {
+		for (auto el : arcs)
+			s << vert_original[el] << " ";
+	}
+
+	void print_arcs(ostream & s, const typename WeightedCSR<Index, Weight>::Range & arcs) const {
+		for (size_t j = 0; j < arcs.size(); ++j)
+			s << vert_original[arcs.target[j]] << "(" << arcs.weight[j] << ") ";
+	}
+
+	// weighted graphs are never packed
+	template <class F>
+	void with_lists(F & f, false_type) const {
+		if (packed())
+			with_in(f, packed_list, packed_in_list, integral_constant<bool, oriented>());
+		else
+			with_in(f, a_list, in_list, integral_constant<bool, oriented>());
+	}
+
+	template <class F>
+	void with_lists(F & f, true_type) const {
+		with_in(f, a_list, in_list, integral_constant<bool, oriented>());
+	}
+
+	template <class F, class Out, class In>
+	static void with_in(F & f, const Out & out, const In & in, true_type) {
+		f(out, in);
+	}
+
+	template <class F, class Out, class In>
+	static void with_in(F & f, const Out & out, const In &, false_type) {
+		f(out, out);
+	}
+
+	// Hooks the union-find trees of u and v, always the larger root under
+	// the smaller one, so it is safe to call for many edges concurrently.
+	static void link(vector<Index> & comp, Index u, Index v) {
+		Index p1 = load_relaxed(comp[u]);
+		Index p2 = load_relaxed(comp[v]);
+		while (p1 != p2) {
+			Index high = max(p1, p2), low = min(p1, p2);
+			Index p_high = load_relaxed(comp[high]);
+			if (p_high == low)
+				break;
+			if (p_high == high && compare_and_swap(comp[high], high, low))
+				break;
+			p1 = load_relaxed(comp[load_relaxed(comp[high])]);
+			p2 = load_relaxed(comp[low]);
+		}
+	}
+
+	// Iterative depth-first search from x with an explicit stack of
+	// (vertex, next neighbour) frames. visit(u, v) is called for every edge v -> u
+	// and returns true if u has to be entered; leave(v) is called when all
+	// edges of v are processed. The caller marks x itself.
+	template <class Adj, class Visit, class Leave>
+	static void dfs_engine(const Adj & adj, Index x, Visit visit, Leave leave, Context & ctx) {
+		auto & frames = ctx.frames_for(adj);
+		frames.clear();
+		frames.push_back({ x, adj[x].begin() });
+		while (!frames.empty()) {
+			Index v = frames.back().first;
+			auto & next = frames.back().second;
+			if (next != adj[v].end()) {
+				Index u = *next;
+				++next;
+				if (visit(u, v))
+					frames.push_back({ u, adj[u].begin() });
+			}
+			else {
+				leave(v);
+				frames.pop_back();
+			}
+		}
+	}
+
+	SpanningTree<Index> get_pred_tree(Workspace<Index> & ws) const {
+		vector<Index> parent(N(), -1);
+		for (auto i : ws.vertices())
+			parent[i] = max<Index>(ws.parent(i), -1);
+		return SpanningTree<Index>(move(parent));
+	}
+
+	// calls f(i, t) for i = 0 .. n - 1 on the thread pool, t being the
+	// number of the thread; threads take the indices in chunks
+	template <class F>
+	void parallel_for(size_t n, F f) const {
+		const size_t GRAIN = 256;
+		atomic<size_t> cursor(0);
+		pool->run([&](int t) {
+			size_t b;
+			while ((b = cursor.fetch_add(GRAIN)) < n) {
+				size_t e = min(b + GRAIN, n);
+				for (size_t i = b; i < e; ++i)
+					f(i, t);
+			}
+		});
+	}
+
+	// Level-synchronous BFS on the thread pool from all vertices of
+	// ctx.front at once. Threads take chunks of the frontier and mark
+	// unvisited neighbours u of v with take(u, v), which returns false if u
+	// is already taken; the sources must be marked by the caller. Reached
+	// vertices are appended to reached if it is given.
+	template <class Adj, class Take>
+	void parallel_bfs(const Adj & adj, Take take, Context & ctx, vector<Index> * reached = nullptr) const {
+		const size_t GRAIN = 64;
+		auto & front = ctx.front;
+		auto & next = ctx.next;
+		auto & local = ctx.local;
+		local.resize(pool->size());
+		while (!front.empty()) {
+			next.clear();
+			if (front.size() < GRAIN) {
+				for (auto v : front) {
+					for (auto u : adj[v]) {
+						if (take(u, v))
+							next.push_back(u);
+					}
+				}
+			}
+			else {
+				atomic<size_t> cursor(0);
+				pool->run([&](int t) {
+					auto & out = local[t];
+					out.clear();
+					size_t b;
+					while ((b = cursor.fetch_add(GRAIN)) < front.size()) {
+						size_t e = min(b + GRAIN, front.size());
+						for (size_t i = b; i < e; ++i) {
+							Index v = front[i];
+							for (auto u : adj[v]) {
+								if (take(u, v))
+									out.push_back(u);
+							}
+						}
+					}
+				});
+				for (auto & out : local)
+					next.insert(next.end(), out.begin(), out.end());
+			}
+			if (reached)
+				reached->insert(reached->end(), next.begin(), next.end());
+			front.swap(next);
+		}
+	}
+
+	// Direction-optimizing BFS: the frontier is expanded top-down while it is
+	// small and every unvisited vertex looks for a parent in the frontier
+	// (kept as a bitmap) once the frontier edges outweigh the unexplored ones.
+	// Bottom-up steps need the reversed lists, without them the search
+	// stays top-down.
+	void bfs(Index x, Context & ctx) const {
+		with_lists([&](const auto & out, const auto & in) { bfs(out, in, x, ctx); });
+	}
+
+	template <class Out, class In>
+	void bfs(const Out & out, const In & in, Index x, Context & ctx) const {
+		auto & ws = ctx.ws;
+		auto & front = ctx.front;
+		auto & next = ctx.next;
+		auto & front_bits = ctx.front_bits;
+		front.assign(1, x);
+		if (pool) {
+			parallel_bfs(out, [&](Index u, Index v) { return ws.claim(u, v); }, ctx, &ws.vertices());
+			return;
+		}
+		const long long ALPHA = 14, BETA = 24;
+		const long long n = N();
+		long long edges_unexplored = out.arcs_number() - out[x].size();
+
+		bool bottom_up = false;
+		while (!front.empty()) {
+			if (!bottom_up && in.size() == N()) {
+				long long edges_front = 0;
+				for (auto v : front)
+					edges_front += out[v].size();
+				bottom_up = edges_front > edges_unexplored / ALPHA;
+			}
+			else if (bottom_up) {
+				bottom_up = (long long)front.size() >= n / BETA;
+			}
+
+			next.clear();
+			if (bottom_up) {
+				front_bits.assign((n + 63) / 64, 0);
+				for (auto v : front)
+					front_bits[v >> 6] |= 1ull << (v & 63);
+				for (Index v = 0; v < n; ++v) {
+					if (ws.visited(v))
+						continue;
+					for (auto u : in[v]) {
+						if (front_bits[u >> 6] >> (u & 63) & 1) {
+							ws.visit(v, u);
+							next.push_back(v);
+							break;
+						}
+					}
+				}
+			}
+			else {
+				for (auto v : front) {
+					for (auto u : out[v]) {
+						if (!ws.visited(u)) {
+							ws.visit(u, v);
+							next.push_back(u);
+						}
+					}
+				}
+			}
+
+			for (auto v : next)
+				edges_unexplored -= out[v].size();
+			front.swap(next);
+		}
+	}
+
+	void dfs(Index x, Context & ctx) const {
+		with_lists([&](const auto & out, const auto &) { dfs(out, x, ctx); });
+	}
+
+	template <class Adj>
+	void dfs(const Adj & adj, Index x, Context & ctx) const {
+		auto & ws = ctx.ws;
+		dfs_engine(adj, x, [&](Index y, Index v) {
+			if (ws.visited(y))
+				return false;
+			ws.visit(y, v);
+			return true;
+		}, [](Index) {}, ctx);
+	}
+
+	template <class Adj>
+	void topo_dfs(const Adj & adj, Index v, Context & ctx) const {
+		auto & ws = ctx.ws;
+		ws.visit(v, -2);
+		dfs_engine(adj, v, [&](Index to, Index u) {
+			if (ws.visited(to))
+				return false;
+			ws.visit(to, u);
+			return true;
+		}, [&](Index u) {
+			ctx.num.push_back(vert_original[u]);
+		}, ctx);
+	}
+
+	// Reachability from sources first .. first + cnt - 1 in a single sweep:
+	// bit k of seen[y] is set iff y is reachable from first + k.
+	// A source is not marked as reachable from itself, like in bfs.
+	// The masks of sw other than seen are all clear between sweeps.
+	void multi_bfs(size_t first, size_t cnt, typename Context::Sweep & sw) const {
+		SourceMask zero;
+		zero.clear();
+		auto & seen = sw.seen;
+		auto & cur = sw.cur;
+		auto & next = sw.next;
+		auto & front = sw.front;
+		auto & next_front = sw.next_front;
+		seen.assign(N(), zero);
+		if (cur.size() != N()) {
+			cur.assign(N(), zero);
+			next.assign(N(), zero);
+		}
+		front.clear();
+		next_front.clear();
+
+		for (size_t k = 0; k < cnt; ++k) {
+			seen[first + k].set(k);
+			cur[first + k].set(k);
+			front.push_back(first + k);
+		}
+
+		with_lists([&](const auto & out, const auto &) {
+			while (!front.empty()) {
+				for (auto v : front) {
+					auto & cv = cur[v];
+					for (auto u : out[v]) {
+						auto & su = seen[u];
+						auto & nu = next[u];
+						bool was_empty = nu.empty();
+						SourceMask::Word added = 0;
+						for (int l = 0; l < SourceMask::LANES; ++l) {
+							auto d = cv.w[l] & ~su.w[l];
+							nu.w[l] |= d;
+							added |= d;
+						}
+						if (added && was_empty)
+							next_front.push_back(u);
+					}
+				}
+				for (auto v : front)
+					cur[v].clear();
+				for (auto u : next_front) {
+					for (int l = 0; l < SourceMask::LANES; ++l)
+						seen[u].w[l] |= next[u].w[l];
+					cur[u] = next[u];
+					next[u].clear();
+				}
+				front.swap(next_front);
+				next_front.clear();
+			}
+		});
+	}
+
+public:
+
+	// number of threads used by traversals, 1 by default
+	void set_threads(int n) {
+		if (n > 1)
+			pool = make_shared<ThreadPool>(n);
+		else
+			pool.reset();
+	}
+
+	int threads() const {
+		return pool ? pool->size() : 1;
+	}
+
+	// Shiloach-Vishkin style components straight from the edge list (the
+	// lists of a packed graph): edges are hooked in parallel, then every vertex is shortcut to its root.
+	// Arcs count in both directions, so an oriented graph gets its weak
+	// components. Components are numbered by their smallest vertex.
+	Components<Index> get_components() const {
+		Index n = N();
+		vector<Index> comp(n);
+		for (Index v = 0; v < n; ++v)
+			comp[v] = v;
+
+		int T = threads();
+		auto hook = [&](int t) {
+			if (packed()) {
+				with_lists([&](const auto & out, const auto &) {
+					for (Index v = n * t / T; v < n * (t + 1) / T; ++v)
+						for (auto u : out[v])
+							link(comp, v, u);
+				});
+				return;
+			}
+			size_t m = e_list.size();
+			for (size_t i = m * t / T; i < m * (t + 1) / T; ++i)
+				link(comp, e_list[i].a, e_list[i].b);
+		};
+		auto shortcut = [&](int t) {
+			for (Index v = n * t / T; v < n * (t + 1) / T; ++v) {
+				Index p = load_relaxed(comp[v]);
+				while (p != load_relaxed(comp[p]))
+					p = load_relaxed(comp[p]);
+				store_relaxed(comp[v], p);
+			}
+		};
+		if (pool) {
+			pool->run(hook);
+			pool->run(shortcut);
+		}
+		else {
+			hook(0);
+			shortcut(0);
+		}
+
+		Components<Index> res;
+		res.id.resize(n);
+		res.offset.assign(1, 0);
+		for (Index v = 0; v < n; ++v) {
+			if (comp[v] == v) {
+				res.id[v] = res.offset.size() - 1;
+				res.offset.push_back(0);
+			}
+			else {
+				res.id[v] = res.id[comp[v]];
+			}
+			++res.offset[res.id[v] + 1];
+		}
+		for (size_t c = 1; c < res.offset.size(); ++c)
+			res.offset[c] += res.offset[c - 1];
+		res.vert.resize(n);
+		vector<Index> pos(res.offset.begin(), res.offset.end() - 1);
+		for (Index v = 0; v < n; ++v)
+			res.vert[pos[res.id[v]]++] = v;
+		return res;
+	}
+
+	// vertices of every component of get_components in original numbers
+	vector<vector<VertexId>> get_connectivity_components() const {
+		auto comps = get_components();
+		vector<vector<VertexId>> res(comps.size());
+		for (size_t c = 0; c < comps.size(); ++c) {
+			for (auto v = comps.begin(c); v != comps.end(c); ++v)
+				res[c].push_back(vert_original[*v]);
+		}
+		return res;
+	}
+
+	// vertices reachable from every vertex, itself not included
+	vector<vector<Index>> get_accessability(Context & ctx) const {
+		vector<vector<Index>> access(N());
+		// batches of sources are independent and fill disjoint access lists
+		size_t batches = (N() + SourceMask::WIDTH - 1) / SourceMask::WIDTH;
+		int T = threads();
+		ctx.sweeps.resize(T);
+		auto sweep = [&](int t) {
+			auto & sw = ctx.sweeps[t];
+			auto & seen = sw.seen;
+			for (size_t b = t; b < batches; b += T) {
+				size_t first = b * SourceMask::WIDTH;
+				size_t cnt = min(N() - first, size_t(SourceMask::WIDTH));
+				multi_bfs(first, cnt, sw);
+				for (size_t y = 0; y < N(); ++y) {
+					for (int l = 0; l < SourceMask::LANES; ++l) {
+						for (auto m = seen[y].w[l]; m; m &= m - 1) {
+							size_t x = first + l * SourceMask::WORD_BITS + SourceMask::lowest_bit(m);
+							if (x != y)
+								access[x].push_back(y);
+						}
+					}
+				}
+			}
+		};
+		if (pool)
+			pool->run(sweep);
+		else
+			sweep(0);
+		return access;
+	}
+
+	pair<vector<vector<Index>>, vector<vector<VertexId>>> get_accessability_and_strong_conn(Context & ctx) const {
+		return make_pair(get_accessability(ctx), get_strong_connected_components(ctx));
+	}
+
+	SpanningTree<Index> get_bfs_tree(Index x, Context & ctx) const {
+		ctx.ws.start(N());
+		ctx.ws.visit(x, -2);
+		bfs(x, ctx);
+		return get_pred_tree(ctx.ws);
+	}
+
+	SpanningTree<Index> get_dfs_tree(Index x, Context & ctx) const {
+		ctx.ws.start(N());
+		ctx.ws.visit(x, -2);
+		dfs(x, ctx);
+		return get_pred_tree(ctx.ws);
+	}
+
+	// the order is also left in ctx.num
+	vector<VertexId> topological_sort(Context & ctx) const {
+		auto & num = ctx.num;
+		ctx.ws.start(N());
+		num.clear();
+		with_lists([&](const auto & out, const auto &) {
+			for (size_t i = 0; i < N(); ++i)
+				if (!ctx.ws.visited(i))
+					topo_dfs(out, i, ctx);
+		});
+		reverse(num.begin(), num.end());
+		return num;
+	}
+
+	// Kahn's algorithm level by level: the vertices left without incoming
+	// arcs form the next layer. In-degrees are counted and every layer is
+	// expanded on the thread pool, threads dropping the counters of the
+	// heads of the arcs they scan.
+	Layers<Index> get_layering(Context & ctx) const {
+		const size_t GRAIN = 256;
+		Index n = N();
+		auto & count = ctx.count;
+		auto & layer = ctx.layer;
+		count.assign(n, 0);
+		layer.assign(n, -1);
+		with_lists([&](const auto & out, const auto &) {
+			if (pool) {
+				parallel_for(n, [&](size_t v, int) {
+					for (auto u : out[v])
+						increment(count[u]);
+				});
+			}
+			else {
+				for (Index v = 0; v < n; ++v)
+					for (auto u : out[v])
+						++count[u];
+			}
+
+			auto & front = ctx.front;
+			auto & next = ctx.next;
+			auto & local = ctx.local;
+			front.clear();
+			for (Index v = 0; v < n; ++v)
+				if (count[v] == 0)
+					front.push_back(v);
+			local.resize(threads());
+			for (Index k = 0; !front.empty(); ++k) {
+				for (auto v : front)
+					layer[v] = k;
+				next.clear();
+				if (pool && front.size() >= GRAIN) {
+					for (auto & el : local)
+						el.clear();
+					parallel_for(front.size(), [&](size_t i, int t) {
+						for (auto u : out[front[i]])
+							if (decrement(count[u]) == 0)
+								local[t].push_back(u);
+					});
+					for (auto & el : local)
+						next.insert(next.end(), el.begin(), el.end());
+				}
+				else {
+					for (auto v : front)
+						for (auto u : out[v])
+							if (--count[u] == 0)
+								next.push_back(u);
+				}
+				front.swap(next);
+			}
+		});
+
+		Layers<Index> res;
+		Index layers = 0;
+		for (Index v = 0; v < n; ++v)
+			layers = max<Index>(layers, layer[v] + 1);
+		res.offset.assign(layers + 1, 0);
+		for (Index v = 0; v < n; ++v)
+			if (layer[v] != -1)
+				++res.offset[layer[v] + 1];
+		for (Index k = 0; k < layers; ++k)
+			res.offset[k + 1] += res.offset[k];
+		res.vert.resize(res.offset[layers]);
+		vector<Index> pos(res.offset.begin(), res.offset.end() - 1);
+		for (Index v = 0; v < n; ++v)
+			if (layer[v] != -1)
+				res.vert[pos[layer[v]]++] = v;
+		if (res.vert.size() != size_t(n))
+			res.cycle = find_cycle(layer);
+		return res;
+	}
+
+private:
+	// Every vertex left out of the layering has an arc from another one,
+	// so going back along such arcs must come round to a vertex seen before.
+	vector<Index> find_cycle(const vector<Index> & layer) const {
+		Index n = N();
+		vector<Index> pred(n, -1);
+		with_lists([&](const auto & out, const auto &) {
+			for (Index v = 0; v < n; ++v) {
+				if (layer[v] != -1)
+					continue;
+				for (auto u : out[v])
+					if (layer[u] == -1)
+						pred[u] = v;
+			}
+		});
+		Index v = 0;
+		while (layer[v] != -1)
+			++v;
+		vector<char> seen(n, 0);
+		for (; !seen[v]; v = pred[v])
+			seen[v] = 1;
+		vector<Index> cycle;
+		Index u = v;
+		do {
+			cycle.push_back(u);
+			u = pred[u];
+		} while (u != v);
+		reverse(cycle.begin(), cycle.end());
+		return cycle;
+	}
+
+public:
+	// layers of get_layering in original numbers, their concatenation is
+	// also left in ctx.num; throws on a cycle
+	vector<vector<VertexId>> get_layers(Context & ctx) const {
+		auto layers = get_layering(ctx);
+		if (!layers.acyclic())
+			throw logic_error("get_layers: the graph has a cycle");
+		vector<vector<VertexId>> res(layers.size());
+		ctx.num.clear();
+		for (size_t k = 0; k < layers.size(); ++k) {
+			for (auto v = layers.begin(k); v != layers.end(k); ++v) {
+				res[k].push_back(vert_original[*v]);
+				ctx.num.push_back(vert_original[*v]);
+			}
+		}
+		return res;
+	}
+
+private:
+	// Pearce's variant of Tarjan's algorithm from x. While v is open,
+	// rindex[v] is the smallest discovery number reachable from it and
+	// root[v] tells whether that is still its own. When a root finishes,
+	// it and the open vertices above it get component number c, counted
+	// down from N - 1; index goes down with every closed vertex, so closed
+	// vertices always compare above the open ones.
+	template <class Adj>
+	void scc_dfs(const Adj & adj, Index x, Index & index, Index & c, Context & ctx) const {
+		auto & ws = ctx.ws;
+		auto & rindex = ctx.rindex;
+		auto & root = ctx.root;
+		auto & open = ctx.open;
+		auto lower = [&](Index v, Index u) {
+			if (rindex[u] < rindex[v]) {
+				rindex[v] = rindex[u];
+				root[v] = 0;
+			}
+		};
+		ws.visit(x, -2);
+		rindex[x] = index++;
+		root[x] = 1;
+		dfs_engine(adj, x, [&](Index u, Index v) {
+			if (!ws.visited(u)) {
+				ws.visit(u, v);
+				rindex[u] = index++;
+				root[u] = 1;
+				return true;
+			}
+			lower(v, u);
+			return false;
+		}, [&](Index v) {
+			if (root[v]) {
+				--index;
+				while (!open.empty() && rindex[v] <= rindex[open.back()]) {
+					rindex[open.back()] = c;
+					open.pop_back();
+					--index;
+				}
+				rindex[v] = c--;
+			}
+			else {
+				open.push_back(v);
+			}
+			if (ws.parent(v) >= 0)
+				lower(ws.parent(v), v);
+		}, ctx);
+	}
+
+	// Strong components on the thread pool, told apart by leader[v] < 2 * N().
+	// Vertices that cannot lie on a cycle are peeled off as single
+	// components. The component of a pivot with many arcs, usually the giant
+	// one, is what a backward search reaches within the forward search from
+	// it. The rest is split by coloring: the largest vertex number spreads
+	// along arcs, and a vertex left with its own label is the root of a
+	// component formed by the vertices of its label that reach it. Whatever a
+	// coloring round does not finish quickly is left to scc_dfs.
+	template <class Out, class In>
+	void parallel_scc(const Out & out, const In & in, vector<Index> & leader, Context & ctx) const {
+		const size_t SEQUENTIAL = 1 << 12;
+		const int MAX_SWEEPS = 64;
+		Index n = N();
+		leader.assign(n, -1);
+		auto & count = ctx.count;
+		count.resize(n);
+		vector<Index> rest;
+		auto remaining = [&] {
+			rest.clear();
+			for (Index v = 0; v < n; ++v)
+				if (leader[v] == -1)
+					rest.push_back(v);
+		};
+
+		// count[v] is the number of arcs into v from the remaining vertices
+		// (out of v if the lists are swapped); peeling a vertex may free more
+		auto peel = [&](const auto & fwd, const auto & back) {
+			parallel_for(n, [&](size_t v, int) {
+				if (leader[v] != -1)
+					return;
+				Index d = 0;
+				for (auto u : back[v])
+					d += leader[u] == -1;
+				count[v] = d;
+			});
+			ctx.front.clear();
+			for (Index v = 0; v < n; ++v) {
+				if (leader[v] == -1 && count[v] == 0) {
+					leader[v] = v;
+					ctx.front.push_back(v);
+				}
+			}
+			parallel_bfs(fwd, [&](Index u, Index) {
+				if (load_relaxed(leader[u]) != -1 || decrement(count[u]) != 0)
+					return false;
+				store_relaxed(leader[u], u);
+				return true;
+			}, ctx);
+		};
+
+		peel(out, in);
+		peel(in, out);
+		remaining();
+		if (!rest.empty()) {
+			Index pivot = rest[0];
+			long long best = -1;
+			for (auto v : rest) {
+				long long arcs = (long long)out[v].size() * in[v].size();
+				if (arcs > best) {
+					best = arcs;
+					pivot = v;
+				}
+			}
+			auto & forward = count;
+			fill(forward.begin(), forward.end(), -1);
+			forward[pivot] = 0;
+			ctx.front.assign(1, pivot);
+			parallel_bfs(out, [&](Index u, Index) { return leader[u] == -1 && claim(forward[u], Index(0)); }, ctx);
+			leader[pivot] = pivot;
+			ctx.front.assign(1, pivot);
+			parallel_bfs(in, [&](Index u, Index) { return forward[u] == 0 && claim(leader[u], pivot); }, ctx);
+			peel(out, in);
+			peel(in, out);
+			remaining();
+		}
+
+		auto & label = count;
+		vector<Index> roots;
+		auto & stack = ctx.local;
+		stack.resize(pool->size());
+		while (rest.size() > SEQUENTIAL) {
+			parallel_for(rest.size(), [&](size_t i, int) { label[rest[i]] = rest[i]; });
+			atomic<bool> changed(true);
+			int sweeps = 0;
+			for (; changed && sweeps < MAX_SWEEPS; ++sweeps) {
+				changed = false;
+				parallel_for(rest.size(), [&](size_t i, int) {
+					Index v = rest[i];
+					Index l = load_relaxed(label[v]);
+					bool raised = false;
+					for (auto u : out[v])
+						raised |= leader[u] == -1 && raise_to(label[u], l);
+					if (raised)
+						changed.store(true, memory_order_relaxed);
+				});
+			}
+			if (changed)
+				break;
+
+			roots.clear();
+			for (auto v : rest)
+				if (label[v] == v)
+					roots.push_back(v);
+			// vertices of one label are only touched by the search of its root
+			parallel_for(roots.size(), [&](size_t i, int t) {
+				Index r = roots[i];
+				auto & st = stack[t];
+				leader[r] = r;
+				st.assign(1, r);
+				while (!st.empty()) {
+					Index v = st.back();
+					st.pop_back();
+					for (auto u : in[v]) {
+						if (label[u] == r && leader[u] == -1) {
+							leader[u] = r;
+							st.push_back(u);
+						}
+					}
+				}
+			});
+			size_t before = rest.size();
+			remaining();
+			if (rest.size() > before - before / 8)
+				break;
+		}
+
+		if (rest.empty())
+			return;
+		// the found components count as closed for scc_dfs
+		auto & ws = ctx.ws;
+		ws.start(n);
+		ctx.rindex.assign(n, 0);
+		ctx.root.assign(n, 0);
+		ctx.open.clear();
+		for (Index v = 0; v < n; ++v) {
+			if (leader[v] != -1) {
+				ws.visit(v, -2);
+				ctx.rindex[v] = numeric_limits<Index>::max();
+			}
+		}
+		Index index = 1, c = n - 1;
+		for (auto v : rest)
+			if (!ws.visited(v))
+				scc_dfs(out, v, index, c, ctx);
+		for (auto v : rest)
+			leader[v] = n + ctx.rindex[v];
+	}
+
+	// Components told apart by leader[v] < 2 * N(), numbered by Kahn's
+	// algorithm on the arcs between them, the ready component with the
+	// smallest vertex first. The numbering depends only on the graph, not
+	// on how the components were found.
+	template <class Adj>
+	Components<Index> topological_components(const Adj & out, const vector<Index> & leader) const {
+		Index n = N();
+		vector<Index> key(2 * n, -1);
+		vector<Index> comp(n);
+		Index count = 0;
+		for (Index v = 0; v < n; ++v) {
+			if (key[leader[v]] == -1)
+				key[leader[v]] = count++;
+			comp[v] = key[leader[v]];
+		}
+		vector<Index> offset(count + 1, 0);
+		for (Index v = 0; v < n; ++v)
+			++offset[comp[v] + 1];
+		for (Index k = 0; k < count; ++k)
+			offset[k + 1] += offset[k];
+		vector<Index> vert(n);
+		vector<Index> pos(offset.begin(), offset.end() - 1);
+		for (Index v = 0; v < n; ++v)
+			vert[pos[comp[v]]++] = v;
+
+		vector<Index> in_arcs(count, 0);
+		for (Index v = 0; v < n; ++v)
+			for (auto u : out[v])
+				in_arcs[comp[u]] += comp[u] != comp[v];
+		// comp numbers go up with the smallest vertex, so a min-heap of
+		// them picks the ready component with the smallest vertex
+		vector<Index> order;
+		order.reserve(count);
+		vector<Index> ready;
+		for (Index k = 0; k < count; ++k)
+			if (in_arcs[k] == 0)
+				ready.push_back(k);
+		while (!ready.empty()) {
+			pop_heap(ready.begin(), ready.end(), greater<Index>());
+			Index k = ready.back();
+			ready.pop_back();
+			order.push_back(k);
+			for (Index i = offset[k]; i < offset[k + 1]; ++i) {
+				for (auto u : out[vert[i]]) {
+					if (comp[u] != k && --in_arcs[comp[u]] == 0) {
+						ready.push_back(comp[u]);
+						push_heap(ready.begin(), ready.end(), greater<Index>());
+					}
+				}
+			}
+		}
+
+		vector<Index> rank(count);
+		for (Index k = 0; k < count; ++k)
+			rank[order[k]] = k;
+		Components<Index> res;
+		res.id.resize(n);
+		res.offset.assign(count + 1, 0);
+		res.vert.resize(n);
+		for (Index k = 0; k < count; ++k)
+			res.offset[k + 1] = res.offset[k] + offset[order[k] + 1] - offset[order[k]];
+		for (Index v = 0; v < n; ++v)
+			res.id[v] = rank[comp[v]];
+		for (Index k = 0; k < count; ++k)
+			copy(vert.begin() + offset[order[k]], vert.begin() + offset[order[k] + 1], res.vert.begin() + res.offset[k]);
+		return res;
+	}
+
+	// strong components by scc_dfs, leader[v] is the component number
+	template <class Adj>
+	void sequential_scc(const Adj & out, vector<Index> & leader, Context & ctx) const {
+		Index n = N();
+		ctx.ws.start(n);
+		ctx.rindex.assign(n, 0);
+		ctx.root.assign(n, 0);
+		ctx.open.clear();
+		Index index = 1, c = n - 1;
+		for (Index i = 0; i < n; ++i)
+			if (!ctx.ws.visited(i))
+				scc_dfs(out, i, index, c, ctx);
+		leader.assign(ctx.rindex.begin(), ctx.rindex.end());
+	}
+
+public:
+	// Strong components, numbered in topological order of the condensation;
+	// of the components ready at each step the one with the smallest vertex
+	// comes first. One depth-first pass, no transposed graph. With threads
+	// and in_list built the work goes to parallel_scc; the result is the same.
+	Components<Index> get_strong_components(Context & ctx) const {
+		Components<Index> res;
+		with_lists([&](const auto & out, const auto & in) {
+			vector<Index> leader;
+			if (pool && in.size() == N())
+				parallel_scc(out, in, leader, ctx);
+			else
+				sequential_scc(out, leader, ctx);
+			res = topological_components(out, leader);
+		});
+		return res;
+	}
+
+	// copy with every arc reversed, see transposed() for a view
+	Graph transpose() const {
+		Graph gt(vert_original, vert_index);
+		for_each_edge([&](Edge e) {
+			swap(e.a, e.b);
+			gt.add_edge(e);
+		});
+		gt.build();
+		gt.build_in_list();
+		return gt;
+	}
+
+	// The graph with every arc reversed, for searches along predecessors.
+	// Nothing is copied: the view runs the searches of the graph with
+	// in_list and a_list (or their packed copies) swapped, so it needs
+	// in_list and is valid while the graph does not change.
+	class TransposedView {
+		const Graph & g;
+
+	public:
+		explicit TransposedView(const Graph & g) : g(g) {}
+
+		size_t N() const {
+			return g.N();
+		}
+
+		// arcs out of v in the view, that is into v in the graph
+		size_t degree(Index v) const {
+			size_t d = 0;
+			g.with_lists([&](const auto &, const auto & in) { d = in[v].size(); });
+			return d;
+		}
+
+		// tree of shortest paths into x in the graph
+		SpanningTree<Index> get_bfs_tree(Index x, Context & ctx) const {
+			ctx.ws.start(N());
+			ctx.ws.visit(x, -2);
+			g.with_lists([&](const auto & out, const auto & in) { g.bfs(in, out, x, ctx); });
+			return g.get_pred_tree(ctx.ws);
+		}
+
+		SpanningTree<Index> get_dfs_tree(Index x, Context & ctx) const {
+			ctx.ws.start(N());
+			ctx.ws.visit(x, -2);
+			g.with_lists([&](const auto &, const auto & in) { g.dfs(in, x, ctx); });
+			return g.get_pred_tree(ctx.ws);
+		}
+
+		// reverse of a topological order of the graph, also left in ctx.num
+		vector<VertexId> topological_sort(Context & ctx) const {
+			auto & num = ctx.num;
+			ctx.ws.start(N());
+			num.clear();
+			g.with_lists([&](const auto &, const auto & in) {
+				for (size_t i = 0; i < N(); ++i)
+					if (!ctx.ws.visited(i))
+						g.topo_dfs(in, i, ctx);
+			});
+			reverse(num.begin(), num.end());
+			return num;
+		}
+	};
+
+	TransposedView transposed() const {
+		bool built = false;
+		with_lists([&](const auto &, const auto & in) { built = in.size() == N(); });
+		if (!built)
+			throw logic_error("transposed view needs build_in_list()");
+		return TransposedView(*this);
+	}
+
+	// vertices of every component of get_strong_components in original numbers
+	vector<vector<VertexId>> get_strong_connected_components(Context & ctx) const {
+		auto comps = get_strong_components(ctx);
+		vector<vector<VertexId>> res(comps.size());
+		for (size_t c = 0; c < comps.size(); ++c) {
+			for (auto v = comps.begin(c); v != comps.end(c); ++v)
+				res[c].push_back(vert_original[*v]);
+		}
+		return res;
+	}
+
+	// vertex c + 1 of the result is component c of get_strong_components
+	Graph get_condensation(Context & ctx) const {
+		auto comps = get_strong_components(ctx);
+		auto & component = comps.id;
+		Graph condensation(comps.size());
+		for_each_edge([&](const Edge & e) {
+			auto ca = component[e.a], cb = component[e.b];
+			if (ca != cb && condensation.arc_value(ca, cb) == no_arc())
+				condensation.add_edge(ca, cb);
+		});
+		condensation.build();
+		return condensation;
+	}
+
+	// Minimum spanning trees of a weighted graph as lists of their edges,
+	// see print_adjacency_list; a disconnected graph gets a spanning forest.
+
+	EdgesList boruvkaMST(Context & ctx) const {
+		EdgesList T;
+		auto & dsu = ctx.dsu;
+		auto & component = ctx.component;
+		auto & min_edge = ctx.min_edge;
+		dsu.reset(N());
+		while (T.size() + 1 < N()) {
+			// components of the forest, numbered by their smallest vertex
+			component.assign(N(), -1);
+			Index c = 0;
+			for (size_t i = 0; i < N(); ++i) {
+				auto & id = component[dsu.find_set(i)];
+				if (id == -1)
+					id = c++;
+			}
+			min_edge.assign(c, -1);
+
+			for (size_t i = 0; i < e_list.size(); ++i) {
+				const Edge & e = e_list[i];
+				auto ac = component[dsu.find_set(e.a)];
+				auto bc = component[dsu.find_set(e.b)];
+				if (ac != bc) {
+					auto & mac = min_edge[ac];
+					auto & mbc = min_edge[bc];
+					if (mac == -1 || e_list[mac].w > e.w)
+						mac = i;
+					if (mbc == -1 || e_list[mbc].w > e.w)
+						mbc = i;
+				}
+			}
+
+			size_t before = T.size();
+			for (auto i : min_edge) {
+				if (i == -1)
+					continue;
+				const Edge & e = e_list[i];
+				if (dsu.find_set(e.a) != dsu.find_set(e.b)) {
+					T.push_back(e);
+					dsu.union_sets(e.a, e.b);
+				}
+			}
+			if (T.size() == before)
+				break;
+		}
+
+		return T;
+	}
+
+	EdgesList primMST(Context & ctx) const {
+		EdgesList T;
+		if (N() == 0)
+			return T;
+
+		// binary heap of candidate edges, the lightest on top
+		auto & q = ctx.heap;
+		q.clear();
+		auto & S = ctx.ws;
+		S.start(N());
+		S.visit(0, -1);
+		auto arcs = a_list[0];
+		for (size_t i = 0; i < arcs.size(); ++i) {
+			q.push_back(Edge::make(0, arcs.target[i], arcs.weight[i]));
+			push_heap(q.begin(), q.end());
+		}
+
+		while (!q.empty()){
+			auto e = q.front();
+			pop_heap(q.begin(), q.end());
+			q.pop_back();
+			if (S.visited(e.b))
+				continue;
+			T.push_back(e);
+			S.visit(e.b, e.a);
+			arcs = a_list[e.b];
+			for (size_t i = 0; i < arcs.size(); ++i) {
+				if (!S.visited(arcs.target[i])) {
+					q.push_back(Edge::make(e.b, arcs.target[i], arcs.weight[i]));
+					push_heap(q.begin(), q.end());
+				}
+			}
+		}
+
+		return T;
+	}
+
+	EdgesList kruskalMST(Context & ctx) const {
+		EdgesList T;
+		auto & d = ctx.dsu;
+		d.reset(N());
+		auto & edges = ctx.heap;
+		edges.assign(e_list.begin(), e_list.end());
+		sort(edges.begin(), edges.end(),
+			[](const Edge & a, const Edge & b) {return a.w < b.w; });
+
+		for (auto & e : edges) {
+			if (d.find_set(e.a) != d.find_set(e.b)) {
+				T.push_back(e);
+				d.union_sets(e.a, e.b);
+			}
+		}
+
+		return T;
+	}
+
+private:
+	SpanningTree<Index, Weight> get_pred_tree(const vector<Index> & pred) const {
+		vector<Weight> weight(N(), 0);
+		for (size_t i = 0; i < N(); ++i) {
+			if (pred[i] >= 0)
+				weight[i] = e_index(pred[i], i);
+		}
+		return SpanningTree<Index, Weight>(pred, move(weight));
+	}
+
+public:
+	// Shortest paths from vertex source of a weighted graph, the distances and
+	// predecessors are left in ctx.d and ctx.pred. The variants differ in
+	// the order the reached vertices are processed in.
+
+	// paths of the last query, by increasing vertex number
+	void print_paths(ostream & s, const Context & ctx) const {
+		auto & d = ctx.d;
+		auto & pred = ctx.pred;
+		s << "Shortest paths:\n";
+		for (auto x : number_order()) {
+			s << d[x] << " : " << vert_original[x];
+			for (Index y = x; pred[y] >= 0; y = pred[y])
+				s << " <- " << vert_original[pred[y]];
+			s << "\n";
+
+		}
+	}
+	SpanningTree<Index, Weight> shortest_paths_tree_stack(Index source, Context & ctx) const {
+		auto & d = ctx.d;
+		auto & pred = ctx.pred;
+		d.assign(N(), infinity());
+		pred.assign(N(), -1);
+
+		auto & bag = ctx.bag;
+		bag.assign(1, { source, 0 });
+		d[source] = 0;
+
+		while (!bag.empty()) {
+			auto x = bag.back().x;
+			bag.pop_back();
+			auto arcs = a_list[x];
+			for (size_t i = 0; i < arcs.size(); ++i) {
+				Index b = arcs.target[i];
+				Weight w = arcs.weight[i];
+				if (d[x] + w < d[b]) {
+					d[b] = d[x] + w;
+					pred[b] = x;
+					bag.push_back({ b, d[b] });
+				}
+			}
+		}
+
+		return get_pred_tree(pred);
+	}
+
+	SpanningTree<Index, Weight> shortest_paths_tree_queue(Index source, Context & ctx) const {
+		auto & d = ctx.d;
+		auto & pred = ctx.pred;
+		d.assign(N(), infinity());
+		pred.assign(N(), -1);
+
+		auto & bag = ctx.bag;
+		bag.assign(1, { source, 0 });
+		d[source] = 0;
+
+		size_t head = 0;
+		while (head < bag.size()) {
+			auto x = bag[head++].x;
+			auto arcs = a_list[x];
+			for (size_t i = 0; i < arcs.size(); ++i) {
+				Index b = arcs.target[i];
+				Weight w = arcs.weight[i];
+				if (d[x] + w < d[b]) {
+					d[b] = d[x] + w;
+					pred[b] = x;
+					bag.push_back({ b, d[b] });
+				}
+			}
+			// drop the processed prefix once it is the larger part
+			if (2 * head > bag.size()) {
+				bag.erase(bag.begin(), bag.begin() + head);
+				head = 0;
+			}
+		}
+
+		return get_pred_tree(pred);
+	}
+
+	SpanningTree<Index, Weight> shortest_paths_tree_priority_queue(Index source, Context & ctx) const {
+		auto & d = ctx.d;
+		auto & pred = ctx.pred;
+		d.assign(N(), infinity());
+		pred.assign(N(), -1);
+
+		// binary heap, the closest vertex on top
+		auto & bag = ctx.bag;
+		bag.assign(1, { source, 0 });
+		d[source] = 0;
+
+		while (!bag.empty()) {
+			auto x = bag.front().x;
+			pop_heap(bag.begin(), bag.end());
+			bag.pop_back();
+			auto arcs = a_list[x];
+			for (size_t i = 0; i < arcs.size(); ++i) {
+				Index b = arcs.target[i];
+				Weight w = arcs.weight[i];
+				if (d[x] + w < d[b]) {
+					d[b] = d[x] + w;
+					pred[b] = x;
+					bag.push_back({ b, d[b] });
+					push_heap(bag.begin(), bag.end());
+				}
+			}
+		}
+
+		return get_pred_tree(pred);
+	}
+};
+
+// Topological order of a DAG kept valid while arcs are added (Pearce and
+// Kelly). An arc x -> y with x already before y costs O(1). Otherwise only
+// the vertices placed between y and x are searched, forward from y and
+// backward from x, and just the ones found swap places. An arc that would
+// close a cycle is refused and the graph is left as it was.
+// The searches run on a copy of the arcs kept here, so added arcs count at
+// once; the graph gets them through add_edge and shows them after build().
+// Vertices are indices of the graph.
+template <class G>
+class DynamicTopologicalOrder {
+	static_assert(G::oriented, "DynamicTopologicalOrder: the graph has to be oriented");
+	typedef typename G::Index Index;
+
+	G & g;
+	vector<vector<Index>> out, in; // arcs of g
+	vector<Index> ord; // position of every vertex
+	vector<Index> vert; // vertex at every position
+	vector<Index> pred; // tree of the forward search, for cycle()
+	vector<char> mark;
+	vector<Index> forward, backward, stack, slots, path;
+
+	// marks what y reaches before x's position, false if that includes x
+	bool search_forward(Index y, Index x) {
+		Index ub = ord[x];
+		forward.assign(1, y);
+		stack.assign(1, y);
+		mark[y] = 1;
+		pred[y] = -1;
+		while (!stack.empty()) {
+			Index v = stack.back();
+			stack.pop_back();
+			if (v == x) {
+				for (; v != -1; v = pred[v])
+					path.push_back(v);
+				reverse(path.begin(), path.end());
+				return false;
+			}
+			for (auto u : out[v]) {
+				if (!mark[u] && ord[u] <= ub) {
+					mark[u] = 1;
+					pred[u] = v;
+					forward.push_back(u);
+					stack.push_back(u);
+				}
+			}
+		}
+		return true;
+	}
+
+	// marks what reaches x after y's position
+	void search_backward(Index x, Index y) {
+		Index lb = ord[y];
+		backward.assign(1, x);
+		stack.assign(1, x);
+		mark[x] = 1;
+		while (!stack.empty()) {
+			Index v = stack.back();
+			stack.pop_back();
+			for (auto u : in[v]) {
+				if (!mark[u] && ord[u] >= lb) {
+					mark[u] = 1;
+					backward.push_back(u);
+					stack.push_back(u);
+				}
+			}
+		}
+	}
+
+	// the found vertices take the positions they held, backward ones first,
+	// each group keeping its relative order
+	void reorder() {
+		auto by_position = [&](Index a, Index b) { return ord[a] < ord[b]; };
+		sort(backward.begin(), backward.end(), by_position);
+		sort(forward.begin(), forward.end(), by_position);
+		slots.clear();
+		for (auto v : backward)
+			slots.push_back(ord[v]);
+		for (auto v : forward)
+			slots.push_back(ord[v]);
+		inplace_merge(slots.begin(), slots.begin() + backward.size(), slots.end());
+		size_t i = 0;
+		for (auto v : backward) {
+			ord[v] = slots[i++];
+			vert[ord[v]] = v;
+		}
+		for (auto v : forward) {
+			ord[v] = slots[i++];
+			vert[ord[v]] = v;
+		}
+	}
+
+public:
+	// starts from a topological_sort of g, which must be acyclic and not packed
+	DynamicTopologicalOrder(G & g, typename G::Context & ctx) : g(g) {
+		if (g.packed())
+			throw logic_error("DynamicTopologicalOrder: the graph is packed");
+		Index n = g.N();
+		out.resize(n);
+		in.resize(n);
+		g.with_lists([&](const auto & adj, const auto &) {
+			for (Index v = 0; v < n; ++v) {
+				for (auto u : adj[v]) {
+					out[v].push_back(u);
+					in[u].push_back(v);
+				}
+			}
+		});
+		g.topological_sort(ctx);
+		ord.resize(n);
+		vert.resize(n);
+		for (Index i = 0; i < n; ++i) {
+			vert[i] = g.vert_index[ctx.num[i]];
+			ord[vert[i]] = i;
+		}
+		for (Index v = 0; v < n; ++v)
+			for (auto u : out[v])
+				if (ord[u] <= ord[v])
+					throw logic_error("DynamicTopologicalOrder: the graph has a cycle");
+		pred.assign(n, -1);
+		mark.assign(n, 0);
+	}
+
+	// adds the arc x -> y to the graph and repairs the order; if y reaches x
+	// returns false without adding it, cycle() is then that path
+	bool add_edge(Index x, Index y) {
+		if (g.packed())
+			throw logic_error("DynamicTopologicalOrder: the graph is packed");
+		path.clear();
+		if (ord[x] < ord[y]) {
+			insert(x, y);
+			return true;
+		}
+		backward.clear();
+		bool acyclic = search_forward(y, x);
+		if (acyclic) {
+			search_backward(x, y);
+			reorder();
+		}
+		for (auto v : forward)
+			mark[v] = 0;
+		for (auto v : backward)
+			mark[v] = 0;
+		if (!acyclic)
+			return false;
+		insert(x, y);
+		return true;
+	}
+
+	// cycle the last refused arc x -> y would close: y -> ... -> x
+	const vector<Index> & cycle() const {
+		return path;
+	}
+
+	// vertices in topological order
+	const vector<Index> & order() const {
+		return vert;
+	}
+
+	Index position(Index v) const {
+		return ord[v];
+	}
+
+private:
+	void insert(Index x, Index y) {
+		g.add_edge(x, y);
+		out[x].push_back(y);
+		in[y].push_back(x);
+	}
+};